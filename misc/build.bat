@@ -23,13 +23,17 @@ if DEFINED DEBUG (
 	echo "Debug build"
 	del *.pdb > NUL 2> NUL
 	echo "LOCK" > LOCK.tmp
-	cl /nologo /DDATA_DIR="\"W:/data/\"" /DEXE_DIR="\"W:/build/\"" /DDEBUG=1 /O2 /Z7 /std:c++17 /MTd /GR- /EHsc /EHa- %WARNINGS% %INCLUDES% /LD         W:\src\Room.cpp     /link /DEBUG:FULL /opt:ref /incremental:no /subsystem:windows %LIBRARIES% /PDB:Room_%RANDOM%.pdb /EXPORT:initialize /EXPORT:boot_down /EXPORT:boot_up /EXPORT:update /EXPORT:render
+	cl /nologo /DDATA_DIR="\"W:/data/\"" /DEXE_DIR="\"W:/build/\"" /DDEBUG=1 /O2 /Z7 /std:c++17 /MTd /GR- /EHsc /EHa- %WARNINGS% %INCLUDES% /LD         W:\src\Room.cpp     /link /DEBUG:FULL /opt:ref /incremental:no /subsystem:windows %LIBRARIES% /PDB:Room_%RANDOM%.pdb /EXPORT:initialize /EXPORT:boot_down /EXPORT:boot_up /EXPORT:update /EXPORT:render /EXPORT:render_headless
 	cl /nologo /DDATA_DIR="\"W:/data/\"" /DEXE_DIR="\"W:/build/\"" /DDEBUG=1 /O2 /Z7 /std:c++17 /MTd /GR- /EHsc /EHa- %WARNINGS% %INCLUDES% /FeRoom.exe W:\src\platform.cpp /link /DEBUG:FULL /opt:ref /incremental:no /subsystem:windows %LIBRARIES%
+	cl /nologo /DDATA_DIR="\"W:/data/\"" /DEXE_DIR="\"W:/build/\"" /DDEBUG=1 /O2 /Z7 /std:c++17 /MTd /GR- /EHsc /EHa- %WARNINGS% %INCLUDES% /FeRoomHeadless.exe W:\src\headless.cpp /link /DEBUG:FULL /opt:ref /incremental:no /subsystem:console %LIBRARIES%
+	cl /nologo /DDATA_DIR="\"W:/data/\"" /DEXE_DIR="\"W:/build/\"" /DDEBUG=1 /O2 /Z7 /std:c++17 /MTd /GR- /EHsc /EHa- %WARNINGS% %INCLUDES% /FeRoomBenchmark.exe W:\src\benchmark.cpp /link /DEBUG:FULL /opt:ref /incremental:no /subsystem:console %LIBRARIES%
 	sleep 0.1
 	del LOCK.tmp
 ) else (
 	echo "Release build"
-	cl /nologo /DDATA_DIR="\"./data/\"" /DEXE_DIR="\"./\"" /O2 /std:c++17 /MTd /GR- /EHsc /EHa- /W4 /wd4201 %INCLUDES% /LD         W:\src\Room.cpp     /link /incremental:no /subsystem:windows %LIBRARIES% /EXPORT:initialize /EXPORT:boot_down /EXPORT:boot_up /EXPORT:update /EXPORT:render
+	cl /nologo /DDATA_DIR="\"./data/\"" /DEXE_DIR="\"./\"" /O2 /std:c++17 /MTd /GR- /EHsc /EHa- /W4 /wd4201 %INCLUDES% /LD         W:\src\Room.cpp     /link /incremental:no /subsystem:windows %LIBRARIES% /EXPORT:initialize /EXPORT:boot_down /EXPORT:boot_up /EXPORT:update /EXPORT:render /EXPORT:render_headless
 	cl /nologo /DDATA_DIR="\"./data/\"" /DEXE_DIR="\"./\"" /O2 /std:c++17 /MTd /GR- /EHsc /EHa- /W4 /wd4201 %INCLUDES% /FeRoom.exe W:\src\platform.cpp /link -incremental:no -subsystem:windows %LIBRARIES%
+	cl /nologo /DDATA_DIR="\"./data/\"" /DEXE_DIR="\"./\"" /O2 /std:c++17 /MTd /GR- /EHsc /EHa- /W4 /wd4201 %INCLUDES% /FeRoomHeadless.exe W:\src\headless.cpp /link -incremental:no -subsystem:console %LIBRARIES%
+	cl /nologo /DDATA_DIR="\"./data/\"" /DEXE_DIR="\"./\"" /O2 /std:c++17 /MTd /GR- /EHsc /EHa- /W4 /wd4201 %INCLUDES% /FeRoomBenchmark.exe W:\src\benchmark.cpp /link -incremental:no -subsystem:console %LIBRARIES%
 )
 popd
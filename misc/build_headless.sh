@@ -0,0 +1,13 @@
+#!/bin/sh
+# Builds RoomHeadless and RoomBenchmark on machines without MSVC; expects SDL2, SDL2_ttf, SDL2_mixer and SDL2_image to be installed and stb/SDL_FontCache in lib/.
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+INCLUDES="$(sdl2-config --cflags) -I $ROOT/lib/stb/ -I $ROOT/lib/SDL_FontCache/"
+LIBRARIES="$(sdl2-config --libs) -lSDL2_ttf -lSDL2_mixer -lSDL2_image -lm -lpthread"
+
+mkdir -p "$ROOT/build/"
+cd "$ROOT/build/" || exit 1
+
+cc  -c -O2 $INCLUDES "$ROOT/lib/SDL_FontCache/SDL_FontCache.c" -o SDL_FontCache.o                                                                            || exit 1
+c++ -O2 -std=c++17 -fno-rtti -DDATA_DIR="\"$ROOT/data/\"" -DEXE_DIR="\"./\"" $INCLUDES "$ROOT/src/headless.cpp" SDL_FontCache.o -o RoomHeadless $LIBRARIES || exit 1
+c++ -O2 -std=c++17 -fno-rtti -DDATA_DIR="\"$ROOT/data/\"" -DEXE_DIR="\"./\"" $INCLUDES "$ROOT/src/benchmark.cpp" SDL_FontCache.o -o RoomBenchmark $LIBRARIES || exit 1
@@ -12,15 +12,18 @@
 #define DEBUG_DISABLE_MIPMAPPING    false
 #define DEBUG_DISABLE_SHADER        false
 #define DEBUG_DISABLE_POSTPROCESSOR false
+#define DEBUG_DISABLE_AVX           false
 #endif
 
 #define STB_IMAGE_IMPLEMENTATION true
 #include <time.h>
+#include <stdio.h>
 #include <stb_image.h>
 #include "unified.h"
 #include "platform.h"
 #include "rng.cpp"
 #include "utilities.cpp"
+#include "profiler.cpp"
 
 #if DEBUG_SHOWCASE_MAP
 global constexpr vi2 DISPLAY_RES = { 540, 360 };
@@ -186,7 +189,7 @@ enum_loose (ItemType, u8)
 	enum_end_region(ITEM)
 };
 
-global constexpr struct { strlit img_file_path; f32 spawn_weight; } ITEM_DATA[ItemType::ITEM_COUNT] =
+global constexpr struct { strlit img_file_path; f32 spawn_weight; } ITEM_DATA[+ItemType::ITEM_COUNT] =
 	{
 		{ DATA_DIR "items/cheap_batteries.png"          , 15.0f },
 		{ DATA_DIR "items/paper.png"                    ,  5.0f },
@@ -254,12 +257,59 @@ struct WallSide
 	vf2       normal;
 };
 
+enum_loose (WallDecoration, u8)
+{
+	none,
+	door,
+	diagonal_door,
+	circuit_breaker,
+	diagonal_circuit_breaker,
+	left_arrow,
+	right_arrow,
+	CAPACITY
+};
+
+global constexpr struct WallDecorationData { vf2 uv_position; vf2 uv_dimensions; } WALL_DECORATION_DATA[+WallDecoration::CAPACITY] =
+	{
+		{ { 0.0f                        , 0.0f  }, { 0.0f         , 0.0f  } },
+		{ { 0.25f                       , 0.0f  }, { 0.5f         , 0.85f } },
+		{ { 0.5f - 0.5f  / 2.0f / SQRT2 , 0.0f  }, { 0.5f  / SQRT2, 0.85f } },
+		{ { 0.35f                       , 0.25f }, { 0.30f        , 0.50f } },
+		{ { 0.5f - 0.30f / 2.0f / SQRT2 , 0.25f }, { 0.30f / SQRT2, 0.50f } },
+		{ { 0.0f                        , 0.0f  }, { 1.0f         , 1.0f  } },
+		{ { 0.0f                        , 0.0f  }, { 1.0f         , 1.0f  } }
+	};
+
 struct PathCoordinatesNode
 {
 	vi2                  coordinates;
 	PathCoordinatesNode* next_node;
 };
 
+global constexpr i32 PATH_VERTEX_COUNT  = MAP_DIM * 2 * MAP_DIM; // @NOTE@ The path coordinates `{ x, y }` are vertex `y * MAP_DIM + x`.
+global constexpr i32 PATH_EDGE_CAPACITY = PATH_VERTEX_COUNT * 6;
+static_assert(PATH_EDGE_CAPACITY <= UINT16_MAX && PATH_VERTEX_COUNT <= UINT16_MAX); // @NOTE@ The edges and vertices of the path graph are indexed with `u16`.
+
+global constexpr i32 PATH_CLUSTER_DIM              = 10; // @NOTE@ Each cluster is a `PATH_CLUSTER_DIM` by `PATH_CLUSTER_DIM` block of cells, which is `PATH_CLUSTER_DIM` by `PATH_CLUSTER_DIM * 2` path coordinates.
+global constexpr i32 PATH_CLUSTERS_PER_SIDE        = MAP_DIM / PATH_CLUSTER_DIM;
+global constexpr i32 PATH_CLUSTER_COUNT            = PATH_CLUSTERS_PER_SIDE * PATH_CLUSTERS_PER_SIDE;
+global constexpr i32 PATH_CLUSTER_VERTEX_COUNT     = PATH_CLUSTER_DIM * 2 * PATH_CLUSTER_DIM;
+global constexpr i32 PATH_ENTRANCE_WIDTH           = 8; // @NOTE@ The most crossing edges that are grouped into one entrance between two clusters.
+global constexpr i32 PATH_REFINED_CLUSTER_COUNT    = 2; // @NOTE@ How many clusters past the starting one `path_find_hierarchical` refines the way through.
+global constexpr i32 PATH_CLUSTER_BORDER_COUNT     = PATH_CLUSTER_DIM * 6 - 4; // @NOTE@ The vertices of a cluster that edges can cross from or into, which are its right column, the odd rows of its left column, its bottom row, and its top two rows.
+global constexpr i32 PATH_TRANSITION_CAPACITY      = PATH_CLUSTER_COUNT * PATH_CLUSTER_BORDER_COUNT; // @NOTE@ Every border vertex being a transition, which is when walls split each entrance down to a single edge.
+global constexpr i32 PATH_TRANSITION_EDGE_CAPACITY = PATH_CLUSTER_COUNT * 1152; // @NOTE@ A budget; the worst case joins all the transitions of every cluster to each other, which would more than double the size of `State`.
+static_assert(MAP_DIM % PATH_CLUSTER_DIM == 0);
+static_assert(PATH_TRANSITION_CAPACITY <= INT16_MAX && PATH_TRANSITION_EDGE_CAPACITY <= UINT16_MAX); // @NOTE@ The transitions are indexed with `i16` while building and `u16` after, and the transition edges with `u16`.
+
+struct PathVertex
+{
+	u32 generation; // @NOTE@ The vertex is only set in the search whose `path_generation` this matches, so the vertices never have to be cleared between searches.
+	i32 heap_index; // @NOTE@ Where the vertex is in the open heap of `path_find`, or -1 if it isn't in it.
+	f32 best_weight;
+	vi2 prev_coordinates;
+};
+
 enum struct StateContext : u8
 {
 	title_menu,
@@ -287,7 +337,7 @@ enum_loose (WindowType, u8)
 	enum_end_region(TYPE)
 };
 
-global struct { vf2 position; vf2 dimensions; strlit name; strlit img_file_path; } WINDOW_ICON_DATA[WindowType::TYPE_COUNT] =
+global struct { vf2 position; vf2 dimensions; strlit name; strlit img_file_path; } WINDOW_ICON_DATA[+WindowType::TYPE_COUNT] =
 	{
 		{ { 32.0f, DISPLAY_RES.y - 100.0f }, vx2(64.0f)                       , "README.txt", DATA_DIR "computer/text_file.png"             },
 		{ { 32.0f, DISPLAY_RES.y - 200.0f }, vx2(64.0f)                       , "Room"      , DATA_DIR "computer/room_protocol.png"         },
@@ -353,7 +403,7 @@ global constexpr struct
 			vf2    start_uv_position;
 			f32    u_length;
 		} slider_buffer[4];
-	} WINDOW_DATA[WindowType::TYPE_COUNT] =
+	} WINDOW_DATA[+WindowType::TYPE_COUNT] =
 	{
 		{
 			{ 300.0f, 325.0f },
@@ -429,7 +479,7 @@ enum_loose (LuciaState, u8)
 	CAPACITY
 };
 
-global constexpr strlit LUCIA_STATE_IMG_FILE_PATHS[LuciaState::CAPACITY] =
+global constexpr strlit LUCIA_STATE_IMG_FILE_PATHS[+LuciaState::CAPACITY] =
 	{
 		DATA_DIR "hud/lucia_normal.png",
 		DATA_DIR "hud/lucia_anxious.png",
@@ -440,13 +490,97 @@ global constexpr strlit LUCIA_STATE_IMG_FILE_PATHS[LuciaState::CAPACITY] =
 		DATA_DIR "hud/lucia_healed.png"
 	};
 
+enum_loose (RenderStage, u8)
+{
+	raycast,
+	sprites,
+	shading,
+	post_process,
+	upload,
+	CAPACITY
+};
+
+enum_loose (RenderPhase, u8) // @NOTE@ Every frame the render threads first cast the view's columns, then shade and post-process them once the main thread has projected the sprites against those columns.
+{
+	cast,
+	shade
+};
+
+enum_loose (SIMDLevel, u8) // @NOTE@ The widest instruction set the CPU supports; the kernels without a wider variant stay on SSE.
+{
+	sse2,
+	avx2,
+	avx512
+};
+
+global constexpr i32 RENDER_THREAD_CAPACITY = 64;
+global constexpr i32 RENDER_CHUNK_WIDTH     = 4;
+global constexpr i32 RENDER_CHUNK_COUNT     = (VIEW_RES.x + RENDER_CHUNK_WIDTH - 1) / RENDER_CHUNK_WIDTH;
+global constexpr i32 VIEW_ROW_PITCH         = (VIEW_RES.x + 3) / 4 * 4; // @NOTE@ Rows of the view are padded to whole SSE registers.
+
+static_assert(RENDER_CHUNK_WIDTH % 4 == 0);
+
+global constexpr i32 MONSTER_LIGHT_BIN_COUNT = 2048;
+
+global constexpr f32 FLASHLIGHT_INNER_CUTOFF = 0.95f;
+global constexpr f32 FLASHLIGHT_OUTER_CUTOFF = 0.93f;
+global constexpr vf3 AMBIENT_COLOR           = { 1.0f, 1.0f, 1.0f };
+global constexpr vf3 FLASHLIGHT_COLOR        = { 1.0f, 1.0f, 0.8f };
+global constexpr vf3 FIRE_COLOR              = { 0.8863f, 0.3451f, 0.1333f };
+
+global constexpr i32 MONSTER_FIRE_COUNT        = 3;
+global constexpr i32 RENDER_SPRITE_CAPACITY    = 1 + MONSTER_FIRE_COUNT + 1 + MAP_DIM * MAP_DIM / 16; // @NOTE@ The monster, its fires, the hand, and every item, each projected once.
+global constexpr i32 RENDER_SPRITES_PER_COLUMN = 16;
+static_assert(RENDER_SPRITE_CAPACITY <= 256); // @NOTE@ `render_sprite_column_indices` are bytes.
+
+enum struct Material : u8
+{
+	null,
+	wall,
+	floor,
+	ceiling,
+	item,
+	monster,
+	hand,
+	fire
+};
+
+struct RenderSprite
+{
+	Material material;
+	Image    image;
+	vf2      start; // @NOTE@ Already moved to the copy of the map closest to Lucia.
+	vf2      end;
+	vf2      normal;
+	f32      z;
+	f32      height;
+	f32      distance_sq;
+	i16      starting_x;
+	i16      ending_x;
+};
+
+struct ViewColumn
+{
+	vf2      ray_horizontal;
+	WallSide wall_side;
+	f32      wall_distance;
+	f32      wall_portion;
+	i32      wall_starting_y;
+	i32      wall_ending_y;
+	Image*   wall_overlay;
+	vf2      wall_overlay_uv_position;
+	vf2      wall_overlay_uv_dimensions;
+};
+
 struct State;
 struct RenderThreadData
 {
-	i32         index;
-	SDL_Thread* thread;
-	MemoryArena arena;
-	State*      state;
+	i32          index;
+	SDL_Thread*  thread;
+	SDL_sem*     clock_in;
+	State*       state;
+	SDL_atomic_t chunk_range; // @NOTE@ The first chunk in the upper 16 bits and one past the last in the lower 16 bits; the owner takes from the front while others steal from the back.
+	u64          stage_counters[+RenderStage::CAPACITY];
 };
 
 struct State
@@ -500,7 +634,7 @@ struct State
 			f32 fps;
 		} settings;
 
-		f32 settings_slider_values[WindowSliderFamily::SETTINGS_COUNT];
+		f32 settings_slider_values[+WindowSliderFamily::SETTINGS_COUNT];
 
 		static_assert(sizeof(settings_slider_values) == sizeof(settings));
 	};
@@ -514,7 +648,7 @@ struct State
 				SDL_Texture* desktop;
 				SDL_Texture* cursor;
 				SDL_Texture* window_close;
-				SDL_Texture* icons[WindowType::TYPE_COUNT];
+				SDL_Texture* icons[+WindowType::TYPE_COUNT];
 			} texture;
 
 			SDL_Texture* textures[sizeof(texture) / sizeof(SDL_Texture*)];
@@ -562,7 +696,7 @@ struct State
 				TextureSprite hand;
 				TextureSprite flashlight_on;
 				TextureSprite night_vision_goggles_on;
-				TextureSprite default_items[ItemType::ITEM_COUNT];
+				TextureSprite default_items[+ItemType::ITEM_COUNT];
 				TextureSprite papers[ARRAY_CAPACITY(PAPER_DATA)];
 			} texture_sprite;
 
@@ -601,7 +735,7 @@ struct State
 				SDL_Texture* circuit_breaker_switches[2];
 				SDL_Texture* circuit_breaker_panel;
 				SDL_Texture* blink;
-				SDL_Texture* lucia_states[LuciaState::CAPACITY];
+				SDL_Texture* lucia_states[+LuciaState::CAPACITY];
 			} texture;
 
 			SDL_Texture* textures[sizeof(texture) / sizeof(SDL_Texture*)];
@@ -653,11 +787,25 @@ struct State
 			Mix_Music* musics[sizeof(music) / sizeof(Mix_Music*)];
 		};
 
-		u32*                 render_thread_view_pixels;
+		u32*                 render_thread_view_pixels; // @NOTE@ Column-major and bottom-up with `VIEW_ROW_PITCH` columns.
+		u32*                 render_thread_target_pixels; // @NOTE@ Where the render threads post-process this frame's view into.
+		f32                  render_thread_blur;
+		RenderPhase          render_thread_phase;
 		bool32               render_thread_fired;
-		SDL_sem*             render_thread_clock_in;
 		SDL_sem*             render_thread_clock_out;
-		RenderThreadData     render_thread_datas[2];
+		i32                  render_thread_count; // @NOTE@ The main thread is always `render_thread_datas[0]` and has no thread of its own.
+		SIMDLevel            render_simd_level;
+		RenderThreadData     render_thread_datas[RENDER_THREAD_CAPACITY];
+		u64                  render_stage_counters[+RenderStage::CAPACITY]; // @NOTE@ Performance counter ticks of the last rendered frame; summed across all render threads, plus the main thread's monster light pass under raycast and its sprite projection under sprites.
+		RenderSprite         render_sprites[RENDER_SPRITE_CAPACITY]; // @NOTE@ Sorted nearest first.
+		i32                  render_sprite_count;
+		u16                  render_sprite_column_offsets[VIEW_RES.x + 1]; // @NOTE@ Column `x` is covered by the sprites indexed by `render_sprite_column_indices[render_sprite_column_offsets[x]]` up to `render_sprite_column_indices[render_sprite_column_offsets[x + 1]]`.
+		u8                   render_sprite_column_indices[VIEW_RES.x * RENDER_SPRITES_PER_COLUMN];
+		f32                  render_row_ray_fov; // @NOTE@ The `lucia_fov` the row rays were last built for.
+		f32                  render_row_ray_xys[VIEW_RES.y]; // @NOTE@ The eye ray through row `y` (bottom-up) is `{ render_column_rays[x] * render_row_ray_xys[y], render_row_ray_zs[y] }`.
+		f32                  render_row_ray_zs [VIEW_RES.y];
+		vf2                  render_column_rays[VIEW_RES.x];
+		ViewColumn           render_view_columns[VIEW_RES.x]; // @NOTE@ What each column's ray hit; cast once per frame before the sprites so they can be culled against it.
 
 		GameGoal             goal;
 
@@ -667,6 +815,29 @@ struct State
 		f32                  blur_value;
 
 		PathCoordinatesNode* available_path_coordinates_node;
+		u16                  path_edge_offsets[PATH_VERTEX_COUNT + 1]; // @NOTE@ The edges out of vertex `i` are `path_edge_targets[path_edge_offsets[i]]` up to `path_edge_targets[path_edge_offsets[i + 1]]`.
+		u16                  path_edge_targets[PATH_EDGE_CAPACITY];
+		u8                   path_edge_steps  [PATH_EDGE_CAPACITY]; // @NOTE@ Which of `PATH_STEPS` each edge is, which also gives its weight.
+		u16                  path_in_edge_offsets[PATH_VERTEX_COUNT + 1]; // @NOTE@ The same edges grouped by the vertex they lead into; the edges into vertex `i` come from `path_in_edge_sources[path_in_edge_offsets[i]]` up to `path_in_edge_sources[path_in_edge_offsets[i + 1]]`.
+		u16*                 path_in_edge_sources; // @NOTE@ Allocated in the context arena for exactly as many edges as the graph has.
+		u8*                  path_in_edge_steps;
+		i32                  path_transition_count;
+		u16                  path_transition_vertices       [PATH_TRANSITION_CAPACITY]; // @NOTE@ The vertices of the cluster graph, grouped by cluster; those of cluster `i` are from `path_cluster_transition_offsets[i]` up to `path_cluster_transition_offsets[i + 1]`.
+		u16                  path_cluster_transition_offsets[PATH_CLUSTER_COUNT + 1];
+		u16                  path_transition_edge_offsets   [PATH_TRANSITION_CAPACITY + 1]; // @NOTE@ Laid out like `path_edge_offsets`, but over the transitions.
+		u16                  path_transition_edge_targets   [PATH_TRANSITION_EDGE_CAPACITY];
+		f32                  path_transition_edge_weights   [PATH_TRANSITION_EDGE_CAPACITY];
+		vi2                  lucia_flow_root; // @NOTE@ The path coordinates the flow field leads to, or `{ -1, -1 }` if it hasn't been set yet.
+		u32                  lucia_flow_generation;
+		u32                  lucia_flow_generations      [PATH_VERTEX_COUNT]; // @NOTE@ A vertex hasn't been reached by the flow field's search unless this matches `lucia_flow_generation`, in which case the rest of its entries are set.
+		f32                  lucia_flow_distances        [PATH_VERTEX_COUNT]; // @NOTE@ Path distance from each vertex to `lucia_flow_root`; only final once the vertex is settled.
+		u16                  lucia_flow_next_hops        [PATH_VERTEX_COUNT]; // @NOTE@ The vertex each vertex steps to next on its shortest path to `lucia_flow_root`.
+		u16                  lucia_flow_heap             [PATH_VERTEX_COUNT]; // @NOTE@ The reached vertices that aren't settled yet, as a binary heap on their distances.
+		i16                  lucia_flow_heap_slots       [PATH_VERTEX_COUNT]; // @NOTE@ Where each vertex is in `lucia_flow_heap`, or -1 if it isn't in there.
+		i32                  lucia_flow_heap_count;
+		u16                  lucia_flow_candidate_marks  [PATH_VERTEX_COUNT]; // @NOTE@ One more than the index of the candidate at each vertex while `settle_lucia_flow_field` runs, and 0 otherwise.
+		PathVertex           path_vertices[MAP_DIM * 2][MAP_DIM];
+		u32                  path_generation;
 		strlit               notification_message;
 		f32                  notification_keytime;
 		f32                  heart_rate_display_values[32];
@@ -679,8 +850,10 @@ struct State
 
 		f32                  percieved_wall_height;
 		WallVoxel            wall_voxels[MAP_DIM][MAP_DIM];
+		u8                   wall_clearances[MAP_DIM][MAP_DIM]; // @NOTE@ Chebyshev distance in cells to the closest cell with any wall voxel, capped at 255.
 		WallSide             door_wall_side;
 		WallSide             circuit_breaker_wall_side;
+		WallDecoration       wall_side_decorations[MAP_DIM][MAP_DIM][ARRAY_CAPACITY(WALL_VOXEL_DATA)][2]; // @NOTE@ By the index into `WALL_VOXEL_DATA` and whether the side faces against the voxel's normal.
 		f32                  creepy_sound_countdown;
 		f32                  ceiling_lights_keytime;
 
@@ -705,11 +878,14 @@ struct State
 		f32                  monster_timeout;
 		PathCoordinatesNode* monster_path;
 		vi2                  monster_path_goal;
+		bool32               monster_path_partial; // @NOTE@ Whether `monster_path` stops short of `monster_path_goal`, so the rest has to be found once it runs out.
+		f32                  monster_path_spliced_distance; // @NOTE@ Length of the detours spliced onto `monster_path` since it was last found in full.
 		vf3                  monster_position;
 		f32                  monster_chase_keytime;
 		f32                  monster_roam_update_keytime;
 		vf2                  monster_velocity;
 		vf2                  monster_normal;
+		f32                  monster_light_depths[MONSTER_LIGHT_BIN_COUNT]; // @NOTE@ Distance from the monster to the closest wall along each diamond-angle bin; rebuilt every rendered frame the monster is out.
 
 		vf3                  hand_position;
 		HandOnState          hand_on_state;
@@ -841,6 +1017,23 @@ internal bool32 equal_wall_sides(WallSide a, WallSide b)
 	return a.coordinates == b.coordinates && a.voxel == b.voxel && a.normal == b.normal;
 }
 
+internal Image* get_wall_decoration_image(State* state, WallDecoration decoration)
+{
+	switch (decoration)
+	{
+		case WallDecoration::none                     : return 0;
+		case WallDecoration::door                     :
+		case WallDecoration::diagonal_door            : return &state->game.image.door;
+		case WallDecoration::circuit_breaker          :
+		case WallDecoration::diagonal_circuit_breaker : return &state->game.image.circuit_breaker;
+		case WallDecoration::left_arrow               : return &state->game.image.wall_left_arrow;
+		case WallDecoration::right_arrow              : return &state->game.image.wall_right_arrow;
+	}
+
+	ASSERT(false);
+	return 0;
+}
+
 internal TextureSprite* get_corresponding_texture_sprite_of_item(State* state, Item* item)
 {
 	switch (item->type)
@@ -1295,712 +1488,2756 @@ internal bool32 exists_clear_way(State* state, vf2 position, vf2 goal)
 	return false;
 }
 
-internal PathCoordinatesNode* path_find(State* state, vi2 start, vi2 end)
+// @NOTE@ Maps the direction of `ray` onto [0, 4) by walking around the unit diamond; monotonic with the angle like `atan2` but without any trigonometry.
+internal f32 get_diamond_angle(vf2 ray)
 {
-	memory_arena_checkpoint(&state->transient_arena);
-
-	struct PathVertex
+	if (ray.y >= 0.0f)
 	{
-		bool32 is_set;
-		f32    best_weight;
-		vi2    prev_coordinates;
-	};
+		return ray.x >= 0.0f ? ray.y / (ray.x + ray.y) : 1.0f - ray.x / (ray.y - ray.x);
+	}
+	else
+	{
+		return ray.x < 0.0f ? 2.0f - ray.y / (-ray.x - ray.y) : 3.0f + ray.x / (ray.x - ray.y);
+	}
+}
+
+internal __m128 get_diamond_angle(__m128 m_x, __m128 m_y)
+{
+	__m128 m_abs_x    = _mm_max_ps(m_x, _mm_sub_ps(m_0, m_x));
+	__m128 m_abs_y    = _mm_max_ps(m_y, _mm_sub_ps(m_0, m_y));
+	__m128 m_negative = _mm_cmplt_ps(m_y, m_0);
+	__m128 m_odd      = _mm_xor_ps(_mm_cmplt_ps(m_x, m_0), m_negative);
+	__m128 m_quadrant = _mm_add_ps(_mm_and_ps(m_negative, m_2), _mm_and_ps(m_odd, m_1));
+	__m128 m_side     = _mm_or_ps(_mm_and_ps(m_odd, m_abs_x), _mm_andnot_ps(m_odd, m_abs_y));
+	return _mm_add_ps(m_quadrant, _mm_div_ps(m_side, _mm_add_ps(m_abs_x, m_abs_y)));
+}
 
-	struct PathQueueNode
+internal vf2 diamond_angle_to_ray(f32 diamond_angle)
+{
+	i32 quadrant = clamp(static_cast<i32>(diamond_angle), 0, 3);
+	f32 t        = diamond_angle - quadrant;
+	switch (quadrant)
 	{
-		f32            estimated_length;
-		vi2            prev_coordinates;
-		vi2            coordinates;
-		PathQueueNode* next_node;
-	};
+		case 0  : return {   1.0f - t ,          t  };
+		case 1  : return {        - t ,   1.0f - t  };
+		case 2  : return { -(1.0f - t),        - t  };
+		default : return {          t , -(1.0f - t) };
+	}
+}
+
+internal i32 get_monster_light_bin(vf2 ray)
+{
+	return min(static_cast<i32>(get_diamond_angle(ray) / 4.0f * MONSTER_LIGHT_BIN_COUNT), MONSTER_LIGHT_BIN_COUNT - 1);
+}
 
-	PathVertex path_vertices[MAP_DIM * 2][MAP_DIM] = {};
-	path_vertices[start.y][start.x].is_set = true;
+// @NOTE@ One DDA per bin from the monster, so lighting a fragment is a lookup instead of a DDA of its own. The depths are capped at a map's width since `ray_to_closest` never goes further.
+internal void compute_monster_light_depths(State* state)
+{
+	PROFILER_scope("compute_monster_light_depths");
 
-	PathQueueNode* path_queue = memory_arena_allocate<PathQueueNode>(&state->transient_arena);
-	path_queue->estimated_length = path_distance_function(start, end);
-	path_queue->prev_coordinates = { -1, -1 };
-	path_queue->coordinates      = start;
-	path_queue->next_node        = 0;
+	constexpr f32 MAX_DEPTH = MAP_DIM * WALL_SPACING;
 
-	PathQueueNode* available_path_queue_node = 0;
+	vf2 position = { mod(state->game.monster_position.x, MAP_DIM * WALL_SPACING), mod(state->game.monster_position.y, MAP_DIM * WALL_SPACING) };
 
-	while (path_queue && path_queue->coordinates != end)
+	FOR_ELEMS(depth, state->game.monster_light_depths)
 	{
-		PathQueueNode* head = path_queue;
-		path_queue = path_queue->next_node;
-
-		struct ADJACENT { WallVoxel side; vi2 delta_coordinates; };
-		constexpr ADJACENT HORI[] =
+		vf2 ray     = normalize(diamond_angle_to_ray((depth_index + 0.5f) * 4.0f / MONSTER_LIGHT_BIN_COUNT));
+		vi2 step    = { sign(ray.x), sign(ray.y) };
+		vf2 t_delta = vf2 { step.x / ray.x, step.y / ray.y } * WALL_SPACING;
+		vf2 t_max   =
 			{
-				{ WallVoxel::bottom, { -1, -1 } },
-				{ WallVoxel::bottom, {  0, -1 } },
-				{ WallVoxel::left  , { -1,  0 } },
-				{ WallVoxel::left  , {  1,  0 } },
-				{ WallVoxel::bottom, { -1,  1 } },
-				{ WallVoxel::bottom, {  0,  1 } }
+				(floorf(position.x / WALL_SPACING + (ray.x >= 0.0f)) * WALL_SPACING - position.x) / ray.x,
+				(floorf(position.y / WALL_SPACING + (ray.y >= 0.0f)) * WALL_SPACING - position.y) / ray.y
 			};
-
-		constexpr ADJACENT VERT[] =
+		vi2 coordinates =
 			{
-				{ WallVoxel::bottom, { 0, -2 } },
-				{ WallVoxel::left  , { 0, -1 } },
-				{ WallVoxel::left  , { 1, -1 } },
-				{ WallVoxel::left  , { 0,  1 } },
-				{ WallVoxel::left  , { 1,  1 } },
-				{ WallVoxel::bottom, { 0,  2 } }
+				static_cast<i32>(floorf(position.x / WALL_SPACING)),
+				static_cast<i32>(floorf(position.y / WALL_SPACING))
 			};
 
-		FOR_ELEMS(it, head->coordinates.y % 2 == 0 ? VERT : HORI)
-		{
-			vi2 next_coordinates =
-				{
-					mod(head->coordinates.x + it->delta_coordinates.x, MAP_DIM    ),
-					mod(head->coordinates.y + it->delta_coordinates.y, MAP_DIM * 2)
-				};
-
-			if (next_coordinates == head->prev_coordinates || +(*get_wall_voxel(state, path_coordinates_to_map_coordinates(next_coordinates)) & it->side))
-			{
-				continue;
-			}
+		*depth = MAX_DEPTH;
 
-			if (head->coordinates.y % 2 == 0)
+		for (f32 entering_distance = 0.0f; entering_distance < *depth;)
+		{
+			FOR_ELEMS(voxel_data, WALL_VOXEL_DATA)
 			{
-				if (it->delta_coordinates.y < 0)
+				if (+(*get_wall_voxel(state, coordinates) & voxel_data->voxel))
 				{
+					f32 distance;
+					f32 portion;
 					if
 					(
-						it->delta_coordinates != vi2 { 1, -1 } && +(*get_wall_voxel(state, path_coordinates_to_map_coordinates(head->coordinates) + vi2 { 0, -1 }) & WallVoxel::back_slash   ) ||
-						it->delta_coordinates != vi2 { 0, -1 } && +(*get_wall_voxel(state, path_coordinates_to_map_coordinates(head->coordinates) + vi2 { 0, -1 }) & WallVoxel::forward_slash)
+						ray_cast_line
+						(
+							&distance,
+							&portion,
+							position,
+							ray,
+							(coordinates + voxel_data->start) * WALL_SPACING,
+							(coordinates + voxel_data->end  ) * WALL_SPACING
+						)
+						&& 0.0f <= portion && portion <= 1.0f
+						&& distance < *depth
 					)
 					{
-						continue;
+						*depth = distance;
 					}
 				}
-				else if
-				(
-					it->delta_coordinates != vi2 { 0, 1 } && +(*get_wall_voxel(state, path_coordinates_to_map_coordinates(head->coordinates)) & WallVoxel::back_slash   ) ||
-					it->delta_coordinates != vi2 { 1, 1 } && +(*get_wall_voxel(state, path_coordinates_to_map_coordinates(head->coordinates)) & WallVoxel::forward_slash)
-				)
-				{
-					continue;
-				}
 			}
-			else if (it->delta_coordinates.x < 0)
+
+			if (t_max.x < t_max.y)
 			{
-				if
-				(
-					it->delta_coordinates != vi2 { -1,  1 } && +(*get_wall_voxel(state, path_coordinates_to_map_coordinates(head->coordinates) + vi2 { -1, 0 }) & WallVoxel::back_slash   ) ||
-					it->delta_coordinates != vi2 { -1, -1 } && +(*get_wall_voxel(state, path_coordinates_to_map_coordinates(head->coordinates) + vi2 { -1, 0 }) & WallVoxel::forward_slash)
-				)
-				{
-					continue;
-				}
+				entering_distance  = t_max.x;
+				t_max.x           += t_delta.x;
+				coordinates.x     += step.x;
 			}
-			else if
-			(
-				it->delta_coordinates != vi2 { 0, -1 } && +(*get_wall_voxel(state, path_coordinates_to_map_coordinates(head->coordinates)) & WallVoxel::back_slash   ) ||
-				it->delta_coordinates != vi2 { 0,  1 } && +(*get_wall_voxel(state, path_coordinates_to_map_coordinates(head->coordinates)) & WallVoxel::forward_slash)
-			)
+			else
 			{
-				continue;
+				entering_distance  = t_max.y;
+				t_max.y           += t_delta.y;
+				coordinates.y     += step.y;
 			}
+		}
+	}
+}
 
-			f32         next_weight = path_vertices[head->coordinates.y][head->coordinates.x].best_weight + path_distance_function(head->coordinates, next_coordinates);
-			PathVertex* next_vertex = &path_vertices[next_coordinates.y][next_coordinates.x];
+// @NOTE@ Same answer as `exists_clear_way` from the monster up to the angular resolution of the bins.
+internal bool32 is_in_monster_light(State* state, vf2 position)
+{
+	vf2 ray = ray_to_closest(state->game.monster_position.xy, position);
+	return ray == vf2 { 0.0f, 0.0f } || norm_sq(ray) < square(state->game.monster_light_depths[get_monster_light_bin(ray)]);
+}
 
-			if (!next_vertex->is_set || next_vertex->best_weight > next_weight)
-			{
-				next_vertex->is_set           = true;
-				next_vertex->best_weight      = next_weight;
-				next_vertex->prev_coordinates = head->coordinates;
+struct PathStep
+{
+	WallVoxel side; // @NOTE@ The side of the wall voxel at the next path coordinates that blocks the step.
+	vi2       delta_coordinates;
+	f32       weight; // @NOTE@ What `path_distance_function` gives for `delta_coordinates`.
+};
 
-				PathQueueNode** repeated_node = &path_queue;
+global constexpr i32      PATH_STEPS_PER_VERTEX = 6;
+global constexpr PathStep PATH_STEPS[PATH_STEPS_PER_VERTEX * 2] = // @NOTE@ The steps out of path coordinates on an even row, then those out of ones on an odd row.
+	{
+		{ WallVoxel::bottom, {  0, -2 }, 2.0f  },
+		{ WallVoxel::left  , {  0, -1 }, 1.0f  },
+		{ WallVoxel::left  , {  1, -1 }, SQRT2 },
+		{ WallVoxel::left  , {  0,  1 }, 1.0f  },
+		{ WallVoxel::left  , {  1,  1 }, SQRT2 },
+		{ WallVoxel::bottom, {  0,  2 }, 2.0f  },
+		{ WallVoxel::bottom, { -1, -1 }, SQRT2 },
+		{ WallVoxel::bottom, {  0, -1 }, 1.0f  },
+		{ WallVoxel::left  , { -1,  0 }, 1.0f  },
+		{ WallVoxel::left  , {  1,  0 }, 1.0f  },
+		{ WallVoxel::bottom, { -1,  1 }, SQRT2 },
+		{ WallVoxel::bottom, {  0,  1 }, 1.0f  }
+	};
 
-				while (*repeated_node && (*repeated_node)->coordinates != next_coordinates)
-				{
-					repeated_node = &(*repeated_node)->next_node;
-				}
+// @NOTE@ The map doesn't change after `generate_map`, so which path coordinates lead to which (and how far apart they are) is worked out once for `path_find`.
+internal void build_path_graph(State* state)
+{
+	i32 edge_count = 0;
+	FOR_RANGE(y, MAP_DIM * 2)
+	{
+		FOR_RANGE(x, MAP_DIM)
+		{
+			vi2 coordinates = { x, y };
+			state->game.path_edge_offsets[y * MAP_DIM + x] = static_cast<u16>(edge_count);
+
+			FOR_ELEMS(it, PATH_STEPS + coordinates.y % 2 * PATH_STEPS_PER_VERTEX, PATH_STEPS_PER_VERTEX)
+			{
+				vi2 next_coordinates =
+					{
+						mod(coordinates.x + it->delta_coordinates.x, MAP_DIM    ),
+						mod(coordinates.y + it->delta_coordinates.y, MAP_DIM * 2)
+					};
 
-				if (*repeated_node)
+				if (+(*get_wall_voxel(state, path_coordinates_to_map_coordinates(next_coordinates)) & it->side))
 				{
-					PathQueueNode* tail = (*repeated_node)->next_node;
-					(*repeated_node)->next_node = available_path_queue_node;
-					available_path_queue_node = *repeated_node;
-					*repeated_node = tail;
+					continue;
 				}
 
-				f32             next_estimated_length = next_weight + path_distance_function(next_coordinates, end);
-				PathQueueNode** post_node             = &path_queue;
-				while (*post_node && (*post_node)->estimated_length < next_estimated_length)
+				if (coordinates.y % 2 == 0)
 				{
-					post_node = &(*post_node)->next_node;
+					if (it->delta_coordinates.y < 0)
+					{
+						if
+						(
+							it->delta_coordinates != vi2 { 1, -1 } && +(*get_wall_voxel(state, path_coordinates_to_map_coordinates(coordinates) + vi2 { 0, -1 }) & WallVoxel::back_slash   ) ||
+							it->delta_coordinates != vi2 { 0, -1 } && +(*get_wall_voxel(state, path_coordinates_to_map_coordinates(coordinates) + vi2 { 0, -1 }) & WallVoxel::forward_slash)
+						)
+						{
+							continue;
+						}
+					}
+					else if
+					(
+						it->delta_coordinates != vi2 { 0, 1 } && +(*get_wall_voxel(state, path_coordinates_to_map_coordinates(coordinates)) & WallVoxel::back_slash   ) ||
+						it->delta_coordinates != vi2 { 1, 1 } && +(*get_wall_voxel(state, path_coordinates_to_map_coordinates(coordinates)) & WallVoxel::forward_slash)
+					)
+					{
+						continue;
+					}
 				}
-
-				PathQueueNode* new_node;
-				if (available_path_queue_node)
+				else if (it->delta_coordinates.x < 0)
 				{
-					new_node                  = available_path_queue_node;
-					available_path_queue_node = available_path_queue_node->next_node;
+					if
+					(
+						it->delta_coordinates != vi2 { -1,  1 } && +(*get_wall_voxel(state, path_coordinates_to_map_coordinates(coordinates) + vi2 { -1, 0 }) & WallVoxel::back_slash   ) ||
+						it->delta_coordinates != vi2 { -1, -1 } && +(*get_wall_voxel(state, path_coordinates_to_map_coordinates(coordinates) + vi2 { -1, 0 }) & WallVoxel::forward_slash)
+					)
+					{
+						continue;
+					}
 				}
-				else
+				else if
+				(
+					it->delta_coordinates != vi2 { 0, -1 } && +(*get_wall_voxel(state, path_coordinates_to_map_coordinates(coordinates)) & WallVoxel::back_slash   ) ||
+					it->delta_coordinates != vi2 { 0,  1 } && +(*get_wall_voxel(state, path_coordinates_to_map_coordinates(coordinates)) & WallVoxel::forward_slash)
+				)
 				{
-					new_node = memory_arena_allocate<PathQueueNode>(&state->transient_arena);
+					continue;
 				}
 
-				new_node->estimated_length = next_estimated_length;
-				new_node->prev_coordinates = head->coordinates;
-				new_node->coordinates      = next_coordinates;
-				new_node->next_node        = *post_node;
-				*post_node = new_node;
+				ASSERT(it->weight == path_distance_function(coordinates, next_coordinates));
+				state->game.path_edge_targets[edge_count] = static_cast<u16>(next_coordinates.y * MAP_DIM + next_coordinates.x);
+				state->game.path_edge_steps  [edge_count] = static_cast<u8>(it - PATH_STEPS);
+				edge_count += 1;
 			}
 		}
-
-		head->next_node = available_path_queue_node;
-		available_path_queue_node = head;
 	}
 
-	PathCoordinatesNode* path = 0;
+	state->game.path_edge_offsets[PATH_VERTEX_COUNT] = static_cast<u16>(edge_count);
 
-	if (path_queue && path_queue->coordinates == end)
+	// @NOTE@ Counts the edges into each vertex first, then scatters every edge into the slice of the vertex it leads into.
+	aliasing in_offsets = state->game.path_in_edge_offsets;
+	FOR_ELEMS(it, in_offsets)
 	{
-		vi2 coordinates = end;
-		while (true)
-		{
-			PathCoordinatesNode* path_coordinates_node = allocate_path_coordinates_node(state);
-			path_coordinates_node->coordinates = coordinates;
-			path_coordinates_node->next_node   = path;
-			path = path_coordinates_node;
+		*it = 0;
+	}
 
-			if (coordinates == start)
-			{
-				break;
-			}
+	FOR_RANGE(i, edge_count)
+	{
+		in_offsets[state->game.path_edge_targets[i] + 1] += 1;
+	}
 
-			coordinates = path_vertices[coordinates.y][coordinates.x].prev_coordinates;
-		}
+	FOR_RANGE(i, PATH_VERTEX_COUNT)
+	{
+		in_offsets[i + 1] += in_offsets[i];
 	}
-	else
+
+	state->game.path_in_edge_sources = memory_arena_allocate<u16>(&state->context_arena, edge_count);
+	state->game.path_in_edge_steps   = memory_arena_allocate<u8 >(&state->context_arena, edge_count);
+
+	u16 cursors[PATH_VERTEX_COUNT];
+	memcpy(cursors, in_offsets, sizeof(cursors));
+
+	FOR_RANGE(source, PATH_VERTEX_COUNT)
 	{
-		ASSERT(false);
+		FOR_RANGE(i, state->game.path_edge_offsets[source], state->game.path_edge_offsets[source + 1])
+		{
+			u16* cursor = &cursors[state->game.path_edge_targets[i]];
+			state->game.path_in_edge_sources[*cursor] = static_cast<u16>(source);
+			state->game.path_in_edge_steps  [*cursor] = state->game.path_edge_steps[i];
+			*cursor += 1;
+		}
 	}
+}
 
-	return path;
+internal i32 get_path_cluster_index(vi2 coordinates)
+{
+	return coordinates.y / (PATH_CLUSTER_DIM * 2) * PATH_CLUSTERS_PER_SIDE + coordinates.x / PATH_CLUSTER_DIM;
 }
 
-enum struct Material : u8
+// @NOTE@ Where the vertex is among the `PATH_CLUSTER_VERTEX_COUNT` vertices of its cluster.
+internal i32 get_path_cluster_vertex_index(vi2 coordinates)
 {
-	null,
-	wall,
-	floor,
-	ceiling,
-	item,
-	monster,
-	hand,
-	fire
-};
+	return coordinates.y % (PATH_CLUSTER_DIM * 2) * PATH_CLUSTER_DIM + coordinates.x % PATH_CLUSTER_DIM;
+}
 
-internal vf3 shader(State* state, vf3 color, Material material, bool32 in_light, vf3 ray, vf3 normal, f32 distance)
+internal bool32 has_path_edge(State* state, i32 source, i32 target)
 {
-#if DEBUG_DISABLE_SHADER
-	return color;
-#else
+	FOR_RANGE(i, state->game.path_edge_offsets[source], state->game.path_edge_offsets[source + 1])
+	{
+		if (state->game.path_edge_targets[i] == target)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
 
-	constexpr f32 FLASHLIGHT_INNER_CUTOFF = 0.95f;
-	constexpr f32 FLASHLIGHT_OUTER_CUTOFF = 0.93f;
+// @NOTE@ Dijkstra from `source` that never leaves its cluster, which goes along the edges backwards if `backwards` so the distances are to `source` rather than from it.
+// `distances` is by `get_path_cluster_vertex_index` and is infinity at the vertices that can't be reached without leaving the cluster.
+internal void search_path_cluster(State* state, vi2 source, bool32 backwards, f32* distances)
+{
+	memory_arena_checkpoint(&state->transient_arena);
 
-	constexpr vf3 AMBIENT_COLOR = { 1.0f, 1.0f, 1.0f };
-	f32 ambient_light =
-		0.5f / (square(distance) / 9.0f / (square(state->game.night_vision_goggles_activation) * 32.0f + 1.0f + (material == Material::item ? 4.0f : 0.0f) + state->game.interpolated_eye_drops_activation * 3.0f) + 1.0f)
-			+ lerp(0.6f, 1.3f, (state->game.lucia_position.z + ray.z * distance) / state->game.percieved_wall_height) * (0.5f - 4.0f * cube(0.5f - state->game.ceiling_lights_keytime));
+	struct PathClusterHeapEntry
+	{
+		f32 distance;
+		u16 index;
+	};
 
-	if (material == Material::item)
+	aliasing offsets       = backwards ? state->game.path_in_edge_offsets : state->game.path_edge_offsets;
+	u16*     neighbors     = backwards ? state->game.path_in_edge_sources : state->game.path_edge_targets;
+	u8*      steps         = backwards ? state->game.path_in_edge_steps   : state->game.path_edge_steps;
+	i32      cluster_index = get_path_cluster_index(source);
+
+	FOR_RANGE(i, PATH_CLUSTER_VERTEX_COUNT)
 	{
-		ambient_light += 0.1f;
+		distances[i] = INFINITY;
 	}
 
-	constexpr vf3 FLASHLIGHT_COLOR = { 1.0f, 1.0f, 0.8f };
-	f32 flashlight_light =
-		(1.0f + powf(square(dot(ray, normal)), 64) * square(dot(ray, state->game.flashlight_ray)) * 0.8f)
-			* clamp((dot(ray, state->game.flashlight_ray) - FLASHLIGHT_OUTER_CUTOFF) / (FLASHLIGHT_INNER_CUTOFF - FLASHLIGHT_OUTER_CUTOFF), 0.0f, 1.0f)
-			/ (square(distance) * 0.1f + 7.0f)
-			* 6.0f
-			* state->game.flashlight_activation;
+	// @NOTE@ A vertex is pushed again every time it gets closer, and the stale entries are skipped when they come out, so there's at most one entry per edge.
+	PathClusterHeapEntry* heap       = memory_arena_allocate<PathClusterHeapEntry>(&state->transient_arena, PATH_CLUSTER_VERTEX_COUNT * 6 + 1);
+	i32                   heap_count = 1;
 
-	constexpr vf3 FIRE_COLOR = { 0.8863f, 0.3451f, 0.1333f };
-	f32 fire_light;
-	if (in_light)
-	{
-		if (material == Material::monster)
+	lambda farther =
+		[](PathClusterHeapEntry a, PathClusterHeapEntry b)
 		{
-			fire_light = 2.0f;
-		}
-		else if (material == Material::fire)
+			return a.distance > b.distance;
+		};
+
+	distances[get_path_cluster_vertex_index(source)] = 0.0f;
+	heap[0] = { 0.0f, static_cast<u16>(source.y * MAP_DIM + source.x) };
+
+	while (heap_count)
+	{
+		std::pop_heap(heap, heap + heap_count, farther);
+		heap_count -= 1;
+
+		PathClusterHeapEntry head = heap[heap_count];
+		if (head.distance > distances[get_path_cluster_vertex_index({ head.index % MAP_DIM, head.index / MAP_DIM })])
 		{
-			fire_light = 3.0f;
+			continue;
 		}
-		else
+
+		FOR_RANGE(i, offsets[head.index], offsets[head.index + 1])
 		{
-			vf3 frag_position = state->game.lucia_position + ray * distance;
-			vf3 frag_ray      = vxx(ray_to_closest(frag_position.xy, state->game.monster_position.xy), state->game.monster_position.z - frag_position.z);
+			vi2 next_coordinates = { neighbors[i] % MAP_DIM, neighbors[i] / MAP_DIM };
+			if (get_path_cluster_index(next_coordinates) != cluster_index)
+			{
+				continue;
+			}
+
+			f32* next_distance = &distances[get_path_cluster_vertex_index(next_coordinates)];
+			if (*next_distance > head.distance + PATH_STEPS[steps[i]].weight)
+			{
+				*next_distance = head.distance + PATH_STEPS[steps[i]].weight;
 
-			fire_light =
-				32.0f
-				* square(clamp(1.0f / (norm(frag_ray) + 0.1f), 0.0f, 1.0f))
-				* fabsf(dot(normalize(frag_ray), normal));
+				ASSERT(heap_count < PATH_CLUSTER_VERTEX_COUNT * 6 + 1);
+				heap[heap_count] = { *next_distance, neighbors[i] };
+				heap_count += 1;
+				std::push_heap(heap, heap + heap_count, farther);
+			}
 		}
 	}
-	else
-	{
-		fire_light = 0.0f;
-	}
-
-	return vf3
-		{
-			clamp((color.x * (AMBIENT_COLOR.x * ambient_light + FLASHLIGHT_COLOR.x * flashlight_light + FIRE_COLOR.x * fire_light)), 0.0f, square(1.0f - state->game.lucia_dying_keytime)),
-			clamp((color.y * (AMBIENT_COLOR.y * ambient_light + FLASHLIGHT_COLOR.y * flashlight_light + FIRE_COLOR.y * fire_light)), 0.0f, square(1.0f - state->game.lucia_dying_keytime)),
-			clamp((color.z * (AMBIENT_COLOR.z * ambient_light + FLASHLIGHT_COLOR.z * flashlight_light + FIRE_COLOR.z * fire_light)), 0.0f, square(1.0f - state->game.lucia_dying_keytime))
-		};
-#endif
 }
 
-internal void render_vertical_scan_line(u32* vertical_scan_line, State* state, MemoryArena arena, i32 x)
+// @NOTE@ Builds the cluster graph that `path_find_hierarchical` plans long ways on. Neighboring edges that cross from one cluster into the same other cluster are grouped into
+// entrances of up to `PATH_ENTRANCE_WIDTH` edges, and only the middle edge of each entrance is kept. The ends of the kept edges are the transitions, which are the vertices of the
+// cluster graph, and the transitions of each cluster are joined to each other by their path distances within it, so those never have to be searched for again.
+internal void build_path_clusters(State* state)
 {
-	u32* current_pixel  = vertical_scan_line;
-	vf2  ray_horizontal = polar(state->game.lucia_angle + (0.5f - static_cast<f32>(x) / VIEW_RES.x) * state->game.lucia_fov);
-
-	WallSide ray_casted_wall_side       = {};
-	f32      wall_distance              = NAN;
-	f32      wall_portion               = NAN;
-	i32      wall_starting_y            = 0;
-	i32      wall_ending_y              = 0;
-	Image*   wall_overlay               = 0;
-	vf2      wall_overlay_uv_position   = { NAN, NAN };
-	vf2      wall_overlay_uv_dimensions = { NAN, NAN };
-	bool32   wall_in_light              = true;
-
-	{
-		vi2 step    = { sign(ray_horizontal.x), sign(ray_horizontal.y) };
-		vf2 t_delta = vf2 { step.x / ray_horizontal.x, step.y / ray_horizontal.y } * WALL_SPACING;
-		vf2 t_max   =
-			{
-				(floorf(state->game.lucia_position.x / WALL_SPACING + (ray_horizontal.x >= 0.0f)) * WALL_SPACING - state->game.lucia_position.x) / ray_horizontal.x,
-				(floorf(state->game.lucia_position.y / WALL_SPACING + (ray_horizontal.y >= 0.0f)) * WALL_SPACING - state->game.lucia_position.y) / ray_horizontal.y
-			};
+	PROFILER_scope("build_path_clusters");
 
-		ray_casted_wall_side.coordinates =
-			{
-				static_cast<i32>(floorf(state->game.lucia_position.x / WALL_SPACING)),
-				static_cast<i32>(floorf(state->game.lucia_position.y / WALL_SPACING))
-			};
+	memory_arena_checkpoint(&state->transient_arena);
 
-		FOR_RANGE(MAP_DIM * MAP_DIM)
+	aliasing edge_offsets = state->game.path_edge_offsets;
+	aliasing edge_targets = state->game.path_edge_targets;
+	i32      edge_count   = edge_offsets[PATH_VERTEX_COUNT];
+
+	lambda get_cluster_index =
+		[](i32 vertex_index)
 		{
-			FOR_ELEMS(voxel_data, WALL_VOXEL_DATA)
+			return get_path_cluster_index({ vertex_index % MAP_DIM, vertex_index / MAP_DIM });
+		};
+
+	// @NOTE@ Consecutive vertices along a cluster's side are two edges apart, so this is how close the ends of two edges have to be for them to be in the same entrance.
+	lambda reaches_within_two_edges =
+		[&](i32 source, i32 target)
+		{
+			if (source == target || has_path_edge(state, source, target))
 			{
-				if (+(*get_wall_voxel(state, ray_casted_wall_side.coordinates) & voxel_data->voxel))
-				{
-					f32 distance;
-					f32 portion;
-					if
-					(
-						ray_cast_line
-						(
-							&distance,
-							&portion,
-							state->game.lucia_position.xy,
-							ray_horizontal,
-							(ray_casted_wall_side.coordinates + voxel_data->start) * WALL_SPACING,
-							(ray_casted_wall_side.coordinates + voxel_data->end  ) * WALL_SPACING
-						)
-						&& 0.0f <= portion && portion <= 1.0f
-						&& (!+ray_casted_wall_side.voxel || distance < wall_distance)
-					)
-					{
-						ray_casted_wall_side.normal = voxel_data->normal;
-						ray_casted_wall_side.voxel  = voxel_data->voxel;
-						wall_distance               = distance;
-						wall_portion                = portion;
+				return true;
+			}
 
-						if (dot(ray_horizontal, voxel_data->normal) > 0.0f)
-						{
-							ray_casted_wall_side.normal *= -1.0f;
-							wall_portion                 = 1.0f - wall_portion;
-						}
-					}
+			FOR_RANGE(i, edge_offsets[source], edge_offsets[source + 1])
+			{
+				if (get_cluster_index(edge_targets[i]) == get_cluster_index(source) && has_path_edge(state, edge_targets[i], target))
+				{
+					return true;
 				}
 			}
 
-			if (+ray_casted_wall_side.voxel)
+			return false;
+		};
+
+	lambda are_neighbors =
+		[&](i32 a, i32 b)
+		{
+			return reaches_within_two_edges(a, b) && reaches_within_two_edges(b, a);
+		};
+
+	i16* edge_entrances  = memory_arena_allocate<i16>(&state->transient_arena, edge_count); // @NOTE@ Which entrance each edge is grouped into, or -1 if it doesn't cross clusters.
+	u8*  entrance_widths = memory_arena_allocate<u8 >(&state->transient_arena, edge_count);
+	i32  entrance_count  = 0;
+
+	FOR_RANGE(i, edge_count)
+	{
+		edge_entrances[i] = -1;
+	}
+
+	FOR_RANGE(source, PATH_VERTEX_COUNT)
+	{
+		i32 source_cluster_index = get_cluster_index(source);
+
+		FOR_RANGE(i, edge_offsets[source], edge_offsets[source + 1])
+		{
+			i32 target_cluster_index = get_cluster_index(edge_targets[i]);
+			if (target_cluster_index == source_cluster_index)
 			{
-				ray_casted_wall_side.coordinates.x = mod(ray_casted_wall_side.coordinates.x, MAP_DIM);
-				ray_casted_wall_side.coordinates.y = mod(ray_casted_wall_side.coordinates.y, MAP_DIM);
+				continue;
+			}
 
-				wall_starting_y = static_cast<i32>(VIEW_RES.y / 2.0f - HORT_TO_VERT_K / state->game.lucia_fov * state->game.lucia_position.z / (wall_distance + lerp(0.01f, 1.0f, state->game.interpolated_pills_effect_activations[0])));
-				wall_ending_y   = static_cast<i32>(VIEW_RES.y / 2.0f + HORT_TO_VERT_K / state->game.lucia_fov * (state->game.percieved_wall_height - state->game.lucia_position.z) / (wall_distance + lerp(0.01f, 3.0f, state->game.interpolated_pills_effect_activations[0])));
+			// @NOTE@ Joins the entrance of an earlier crossing edge whose ends are the same as or neighbors of this edge's, so a way through either edge can just as well go through the other.
+			// Only the vertices within two edges of `source` can be its neighbors.
+			i32 entrance_index = -1;
 
-				if (equal_wall_sides(ray_casted_wall_side, state->game.door_wall_side))
+			lambda join_edges_from =
+				[&](i32 other_source)
 				{
-					wall_overlay = &state->game.image.door;
-
-					if (+(state->game.door_wall_side.voxel & (WallVoxel::back_slash | WallVoxel::forward_slash)))
+					FOR_RANGE(j, edge_offsets[other_source], edge_offsets[other_source + 1])
 					{
-						wall_overlay_uv_position   = { 0.5f - 0.5f / 2.0f / SQRT2, 0.0f };
-						wall_overlay_uv_dimensions = { 0.5f / SQRT2, 0.85f };
-					}
-					else
-					{
-						wall_overlay_uv_position   = { 0.25f, 0.0f };
-						wall_overlay_uv_dimensions = { 0.5f, 0.85f };
+						if
+						(
+							entrance_index == -1 &&
+							edge_entrances[j] != -1 &&
+							entrance_widths[edge_entrances[j]] < PATH_ENTRANCE_WIDTH &&
+							get_cluster_index(edge_targets[j]) == target_cluster_index &&
+							are_neighbors(other_source, source) &&
+							are_neighbors(edge_targets[j], edge_targets[i])
+						)
+						{
+							entrance_index = edge_entrances[j];
+						}
 					}
-				}
-				else if (equal_wall_sides(ray_casted_wall_side, state->game.circuit_breaker_wall_side))
+				};
+
+			join_edges_from(source);
+			FOR_RANGE(j, edge_offsets[source], edge_offsets[source + 1])
+			{
+				if (get_cluster_index(edge_targets[j]) == source_cluster_index)
 				{
-					wall_overlay = &state->game.image.circuit_breaker;
+					join_edges_from(edge_targets[j]);
 
-					if (+(state->game.door_wall_side.voxel & (WallVoxel::back_slash | WallVoxel::forward_slash)))
+					FOR_RANGE(k, edge_offsets[edge_targets[j]], edge_offsets[edge_targets[j] + 1])
 					{
-						wall_overlay_uv_position   = { 0.5f - 0.30f / 2.0f / SQRT2, 0.25f };
-						wall_overlay_uv_dimensions = { 0.30f / SQRT2, 0.50f };
-					}
-					else
-					{
-						wall_overlay_uv_position   = { 0.35f, 0.25f };
-						wall_overlay_uv_dimensions = { 0.30f, 0.50f };
+						if (get_cluster_index(edge_targets[k]) == source_cluster_index)
+						{
+							join_edges_from(edge_targets[k]);
+						}
 					}
 				}
-				else if (rng(static_cast<i32>((ray_casted_wall_side.coordinates.x + ray_casted_wall_side.coordinates.y) * 317.14f + ray_casted_wall_side.coordinates.y * 17102.012f + 962.0f)) < 0.1f)
-				{
-					f32 direction =
-						dot
-						(
-							rotate90(ray_casted_wall_side.normal),
-							normalize(ray_to_closest(get_position_of_wall_side(ray_casted_wall_side, 0.0f), get_position_of_wall_side(state->game.door_wall_side, 0.0f)))
-						);
+			}
 
-					constexpr f32 THRESHOLD = 0.7f;
+			if (entrance_index == -1)
+			{
+				ASSERT(entrance_count < INT16_MAX);
+				entrance_index                  = entrance_count;
+				entrance_widths[entrance_index] = 0;
+				entrance_count                 += 1;
+			}
 
-					if (direction < -THRESHOLD)
-					{
-						wall_overlay = &state->game.image.wall_left_arrow;
-					}
-					else if (direction > THRESHOLD)
-					{
-						wall_overlay = &state->game.image.wall_right_arrow;
-					}
+			edge_entrances [i]               = static_cast<i16>(entrance_index);
+			entrance_widths[entrance_index] += 1;
+		}
+	}
 
-					wall_overlay_uv_position   = { 0.0f, 0.0f };
-					wall_overlay_uv_dimensions = { 1.0f, 1.0f };
-				}
+	// @NOTE@ Keeps the middle edge of each entrance and marks both of its ends as transitions.
+	bool8* kept_edges         = memory_arena_allocate_zero<bool8>(&state->transient_arena, edge_count);
+	u8*    entrance_counts    = memory_arena_allocate_zero<u8   >(&state->transient_arena, entrance_count);
+	i16*   vertex_transitions = memory_arena_allocate      <i16  >(&state->transient_arena, PATH_VERTEX_COUNT); // @NOTE@ Which transition each vertex is, or -1 if it isn't one.
+
+	FOR_RANGE(i, PATH_VERTEX_COUNT)
+	{
+		vertex_transitions[i] = -1;
+	}
 
-				if (wall_overlay && !IN_RANGE(wall_portion, wall_overlay_uv_position.x, wall_overlay_uv_position.x + wall_overlay_uv_dimensions.x))
+	FOR_RANGE(source, PATH_VERTEX_COUNT)
+	{
+		FOR_RANGE(i, edge_offsets[source], edge_offsets[source + 1])
+		{
+			if (edge_entrances[i] != -1)
+			{
+				entrance_counts[edge_entrances[i]] += 1;
+				if (entrance_counts[edge_entrances[i]] == (entrance_widths[edge_entrances[i]] + 1) / 2)
 				{
-					wall_overlay = 0;
+					kept_edges[i]                       = true;
+					vertex_transitions[source]          = 0;
+					vertex_transitions[edge_targets[i]] = 0;
 				}
+			}
+		}
+	}
 
-				wall_in_light =
-					state->game.monster_timeout == 0.0f
-						&& dot(ray_to_closest(state->game.lucia_position.xy + ray_horizontal * wall_distance, state->game.monster_position.xy), ray_casted_wall_side.normal) > 0.0f
-						&& exists_clear_way(state, state->game.monster_position.xy, state->game.lucia_position.xy + ray_horizontal * wall_distance * 0.99f);
+	// @NOTE@ Numbers the transitions cluster by cluster so the ones of each cluster are contiguous.
+	state->game.path_transition_count = 0;
+	FOR_RANGE(cluster_index, PATH_CLUSTER_COUNT)
+	{
+		state->game.path_cluster_transition_offsets[cluster_index] = static_cast<u16>(state->game.path_transition_count);
 
-				break;
+		FOR_RANGE(y, cluster_index / PATH_CLUSTERS_PER_SIDE * PATH_CLUSTER_DIM * 2, (cluster_index / PATH_CLUSTERS_PER_SIDE + 1) * PATH_CLUSTER_DIM * 2)
+		{
+			FOR_RANGE(x, cluster_index % PATH_CLUSTERS_PER_SIDE * PATH_CLUSTER_DIM, (cluster_index % PATH_CLUSTERS_PER_SIDE + 1) * PATH_CLUSTER_DIM)
+			{
+				if (vertex_transitions[y * MAP_DIM + x] != -1)
+				{
+					ASSERT(state->game.path_transition_count < PATH_TRANSITION_CAPACITY);
+					vertex_transitions[y * MAP_DIM + x]                                     = static_cast<i16>(state->game.path_transition_count);
+					state->game.path_transition_vertices[state->game.path_transition_count] = static_cast<u16>(y * MAP_DIM + x);
+					state->game.path_transition_count                                      += 1;
+				}
 			}
+		}
+	}
+	state->game.path_cluster_transition_offsets[PATH_CLUSTER_COUNT] = static_cast<u16>(state->game.path_transition_count);
 
-			if (t_max.x < t_max.y)
+	f32*   distances                = memory_arena_allocate<f32>(&state->transient_arena, PATH_CLUSTER_VERTEX_COUNT);
+	i32    transition_edge_count    = 0;
+	bool32 transition_edges_overrun = false;
+
+	lambda add_transition_edge =
+		[&](i32 target, f32 weight)
+		{
+			if (transition_edge_count == PATH_TRANSITION_EDGE_CAPACITY)
 			{
-				t_max.x                            += t_delta.x;
-				ray_casted_wall_side.coordinates.x += step.x;
+				transition_edges_overrun = true;
 			}
 			else
 			{
-				t_max.y                            += t_delta.y;
-				ray_casted_wall_side.coordinates.y += step.y;
+				state->game.path_transition_edge_targets[transition_edge_count] = static_cast<u16>(target);
+				state->game.path_transition_edge_weights[transition_edge_count] = weight;
+				transition_edge_count += 1;
+			}
+		};
+
+	FOR_RANGE(transition_index, state->game.path_transition_count)
+	{
+		if (transition_edges_overrun)
+		{
+			break;
+		}
+
+		i32 vertex_index  = state->game.path_transition_vertices[transition_index];
+		i32 cluster_index = get_cluster_index(vertex_index);
+		state->game.path_transition_edge_offsets[transition_index] = static_cast<u16>(transition_edge_count);
+
+		search_path_cluster(state, { vertex_index % MAP_DIM, vertex_index / MAP_DIM }, false, distances);
+		FOR_RANGE(other_index, state->game.path_cluster_transition_offsets[cluster_index], state->game.path_cluster_transition_offsets[cluster_index + 1])
+		{
+			i32 other_vertex_index = state->game.path_transition_vertices[other_index];
+			f32 distance           = distances[get_path_cluster_vertex_index({ other_vertex_index % MAP_DIM, other_vertex_index / MAP_DIM })];
+			if (other_index != transition_index && distance != INFINITY)
+			{
+				add_transition_edge(other_index, distance);
 			}
 		}
+
+		FOR_RANGE(i, edge_offsets[vertex_index], edge_offsets[vertex_index + 1])
+		{
+			if (kept_edges[i])
+			{
+				add_transition_edge(vertex_transitions[edge_targets[i]], PATH_STEPS[state->game.path_edge_steps[i]].weight);
+			}
+		}
+	}
+
+	if (transition_edges_overrun)
+	{
+		// @NOTE@ Leaves the map without a cluster graph, so `path_find_hierarchical` plans everything with `path_find`.
+		DEBUG_printf("The cluster graph needs more than %d edges; falling back to `path_find`.\n", PATH_TRANSITION_EDGE_CAPACITY);
+		state->game.path_transition_count = 0;
 	}
+	else
+	{
+		state->game.path_transition_edge_offsets[state->game.path_transition_count] = static_cast<u16>(transition_edge_count);
+	}
+}
+
+// @NOTE@ Sets up a Dijkstra from `root` along the edges backwards, which gives every vertex its path distance to `root` and the first step of the way there.
+// The search only runs as far as the vertices that are asked about (see `settle_lucia_flow_field`), and it picks up where it left off for the next one,
+// so a flow field is only started over when `root` changes and every pursuer after the first mostly gets its step for free.
+internal void set_lucia_flow_root(State* state, vi2 root)
+{
+	if (root == state->game.lucia_flow_root)
+	{
+		return;
+	}
+
+	state->game.lucia_flow_root        = root;
+	state->game.lucia_flow_generation += 1;
+	if (state->game.lucia_flow_generation == 0)
+	{
+		memset(state->game.lucia_flow_generations, 0, sizeof(state->game.lucia_flow_generations));
+		state->game.lucia_flow_generation = 1;
+	}
+
+	i32 root_index = root.y * MAP_DIM + root.x;
+	state->game.lucia_flow_generations[root_index] = state->game.lucia_flow_generation;
+	state->game.lucia_flow_distances  [root_index] = 0.0f;
+	state->game.lucia_flow_next_hops  [root_index] = static_cast<u16>(root_index);
+	state->game.lucia_flow_heap_slots [root_index] = 0;
+	state->game.lucia_flow_heap[0]                 = static_cast<u16>(root_index);
+	state->game.lucia_flow_heap_count              = 1;
+}
+
+// @NOTE@ Runs the flow field's search until the first of the candidates is settled, which is the one with the shortest path to `lucia_flow_root`, and returns its index
+// (or -1 if none of them have a way there).
+internal i32 settle_lucia_flow_field(State* state, vi2* candidates, i32 candidate_count)
+{
+	PROFILER_scope("settle_lucia_flow_field");
 
-	struct RenderScanNode
-	{
-		Material        material;
-		bool8           in_light;
-		i16             starting_y;
-		i16             ending_y;
-		Image           image;
-		vf2             normal;
-		f32             distance;
-		f32             portion;
-		RenderScanNode* next_node;
+	ASSERT(candidate_count < UINT16_MAX);
+
+	aliasing generations     = state->game.lucia_flow_generations;
+	u32      generation      = state->game.lucia_flow_generation;
+	aliasing distances       = state->game.lucia_flow_distances;
+	aliasing next_hops       = state->game.lucia_flow_next_hops;
+	aliasing heap            = state->game.lucia_flow_heap;
+	aliasing heap_slots      = state->game.lucia_flow_heap_slots;
+	aliasing heap_count      = state->game.lucia_flow_heap_count;
+	aliasing candidate_marks = state->game.lucia_flow_candidate_marks;
+
+	lambda reach =
+		[&](i32 index)
+		{
+			if (generations[index] != generation)
+			{
+				generations[index] = generation;
+				distances  [index] = INFINITY;
+				heap_slots [index] = -1;
+			}
+		};
+
+	DEFER
+	{
+		FOR_RANGE(i, candidate_count)
+		{
+			candidate_marks[candidates[i].y * MAP_DIM + candidates[i].x] = 0;
+		}
 	};
 
-	RenderScanNode* render_scan_node = 0;
+	// @NOTE@ The vertices still waiting to be settled come out of the heap no nearer than any that already are, so an already settled candidate wins if there's one.
+	i32 nearest_candidate = -1;
+	FOR_RANGE(i, candidate_count)
+	{
+		i32 index = candidates[i].y * MAP_DIM + candidates[i].x;
+		reach(index);
+		if (distances[index] != INFINITY && heap_slots[index] == -1)
+		{
+			if (nearest_candidate == -1 || distances[index] < distances[candidates[nearest_candidate].y * MAP_DIM + candidates[nearest_candidate].x])
+			{
+				nearest_candidate = i;
+			}
+		}
+		else if (!candidate_marks[index])
+		{
+			candidate_marks[index] = static_cast<u16>(i + 1);
+		}
+	}
+
+	if (nearest_candidate != -1)
+	{
+		return nearest_candidate;
+	}
+
+	lambda swap_entries =
+		[&](i32 i, i32 j)
+		{
+			u16 vertex_index = heap[i];
+			heap[i] = heap[j];
+			heap[j] = vertex_index;
+			heap_slots[heap[i]] = static_cast<i16>(i);
+			heap_slots[heap[j]] = static_cast<i16>(j);
+		};
 
-	__m128 m_delta_checks_x;
-	__m128 m_delta_checks_y;
+	while (heap_count)
 	{
-		vf2 lucia_position_uv = state->game.lucia_position.xy / (MAP_DIM * WALL_SPACING);
+		u16 head_index = heap[0];
+		swap_entries(0, heap_count - 1);
+		heap_count            -= 1;
+		heap_slots[head_index] = -1;
+
+		for (i32 slot = 0;;)
+		{
+			i32 nearest = slot;
+			FOR_RANGE(child, slot * 2 + 1, min(slot * 2 + 3, heap_count))
+			{
+				if (distances[heap[child]] < distances[heap[nearest]])
+				{
+					nearest = child;
+				}
+			}
+
+			if (nearest == slot)
+			{
+				break;
+			}
+
+			swap_entries(slot, nearest);
+			slot = nearest;
+		}
+
+		FOR_RANGE(i, state->game.path_in_edge_offsets[head_index], state->game.path_in_edge_offsets[head_index + 1])
+		{
+			u16 source   = state->game.path_in_edge_sources[i];
+			f32 distance = distances[head_index] + PATH_STEPS[state->game.path_in_edge_steps[i]].weight;
+			reach(source);
+			if (distance < distances[source])
+			{
+				if (distances[source] == INFINITY)
+				{
+					heap[heap_count]   = source;
+					heap_slots[source] = static_cast<i16>(heap_count);
+					heap_count        += 1;
+				}
+
+				distances[source] = distance;
+				next_hops[source] = head_index;
 
-		m_delta_checks_x = _mm_mul_ps(_mm_set_ps(0.0f, 1.0f, 0.0f, 1.0f), _mm_set_ps1((2.0f * roundf(lucia_position_uv.x) - 1.0f) * MAP_DIM * WALL_SPACING));
-		m_delta_checks_y = _mm_mul_ps(_mm_set_ps(0.0f, 0.0f, 1.0f, 1.0f), _mm_set_ps1((2.0f * roundf(lucia_position_uv.y) - 1.0f) * MAP_DIM * WALL_SPACING));
+				for (i32 slot = heap_slots[source]; slot > 0 && distances[heap[slot]] < distances[heap[(slot - 1) / 2]]; slot = (slot - 1) / 2)
+				{
+					swap_entries(slot, (slot - 1) / 2);
+				}
+			}
+		}
 
-		if (fabs(lucia_position_uv.x - roundf(lucia_position_uv.x)) > fabs(lucia_position_uv.y - roundf(lucia_position_uv.y)))
+		if (candidate_marks[head_index])
 		{
-			m_delta_checks_x = _mm_shuffle_ps(m_delta_checks_x, m_delta_checks_x, _MM_SHUFFLE(3, 1, 2, 0));
-			m_delta_checks_y = _mm_shuffle_ps(m_delta_checks_y, m_delta_checks_y, _MM_SHUFFLE(3, 1, 2, 0));
+			return candidate_marks[head_index] - 1;
 		}
 	}
 
-	constexpr f32 SHADER_INV_EPSILON = 0.9f;
+	return -1;
+}
 
-	__m128 m_lucia_x    = _mm_set_ps1(state->game.lucia_position.x);
-	__m128 m_lucia_y    = _mm_set_ps1(state->game.lucia_position.y);
-	__m128 m_ray_x      = _mm_set_ps1(ray_horizontal.x);
-	__m128 m_ray_y      = _mm_set_ps1(ray_horizontal.y);
-	__m128 m_max_scalar = _mm_set_ps1(+ray_casted_wall_side.voxel ? wall_distance : INFINITY);
+// @NOTE@ The same kind of path that `path_find` gives, but read off the flow field, so it's null if there's no way from `start` to `lucia_flow_root`.
+// The vertices along it were all settled before `start` was, so their next hops are final.
+internal PathCoordinatesNode* follow_lucia_flow_field(State* state, vi2 start)
+{
+	if (settle_lucia_flow_field(state, &start, 1) == -1)
+	{
+		return 0;
+	}
 
-	lambda scan =
-		[&](Material material, Image image, vf3 position, vf2 normal, vf2 dimensions)
+	i32 index = start.y * MAP_DIM + start.x;
+
+	PathCoordinatesNode*  path      = 0;
+	PathCoordinatesNode** next_node = &path;
+	while (true)
+	{
+		PathCoordinatesNode* path_coordinates_node = allocate_path_coordinates_node(state);
+		path_coordinates_node->coordinates = { index % MAP_DIM, index / MAP_DIM };
+		path_coordinates_node->next_node   = 0;
+		*next_node = path_coordinates_node;
+		next_node  = &path_coordinates_node->next_node;
+
+		if (index == state->game.lucia_flow_next_hops[index])
 		{
-			__m128 m_start_x          = _mm_add_ps(_mm_set_ps1(position.x + normal.y * dimensions.x / 2.0f), m_delta_checks_x);
-			__m128 m_end_x            = _mm_add_ps(_mm_set_ps1(position.x - normal.y * dimensions.x / 2.0f), m_delta_checks_x);
-			__m128 m_start_y          = _mm_add_ps(_mm_set_ps1(position.y - normal.x * dimensions.x / 2.0f), m_delta_checks_y);
-			__m128 m_end_y            = _mm_add_ps(_mm_set_ps1(position.y + normal.x * dimensions.x / 2.0f), m_delta_checks_y);
-			__m128 m_start_to_end_x   = _mm_sub_ps(m_end_x, m_start_x);
-			__m128 m_start_to_end_y   = _mm_sub_ps(m_end_y, m_start_y);
-			__m128 m_start_to_lucia_x = _mm_sub_ps(m_lucia_x, m_start_x);
-			__m128 m_start_to_lucia_y = _mm_sub_ps(m_lucia_y, m_start_y);
-			__m128 m_det              = _mm_sub_ps(_mm_mul_ps(m_ray_x, m_start_to_end_y), _mm_mul_ps(m_ray_y, m_start_to_end_x));
-			__m128 m_scalar           = _mm_div_ps(_mm_sub_ps(_mm_mul_ps(m_start_to_lucia_y, m_start_to_end_x), _mm_mul_ps(m_start_to_lucia_x, m_start_to_end_y)), m_det);
-			__m128 m_portion          = _mm_div_ps(_mm_sub_ps(_mm_mul_ps(m_start_to_lucia_y, m_ray_x         ), _mm_mul_ps(m_start_to_lucia_x, m_ray_y         )), m_det);
-			i32    mask               = _mm_movemask_ps(_mm_and_ps(_mm_and_ps(_mm_cmpge_ps(m_scalar, m_0), _mm_cmplt_ps(m_scalar, m_max_scalar)), _mm_and_ps(_mm_cmpge_ps(m_portion, m_0), _mm_cmplt_ps(m_portion, m_1))));
-
-			if (mask)
-			{
-				f32 scalars[4];
-				f32 portions[4];
-				_mm_storeu_ps(scalars, m_scalar);
-				_mm_storeu_ps(portions, m_portion);
+			break;
+		}
 
-				FOR_RANGE(i, 4)
+		index = state->game.lucia_flow_next_hops[index];
+	}
+
+	return path;
+}
+
+// @NOTE@ Instead of throwing the path away whenever Lucia changes cells, it's kept up to whichever of `start` and its remaining vertices is nearest to her new cell
+// and continued from there along the flow field. Finding that vertex only searches about as far as she moved, not as far as she is.
+// What's kept was only the best way to where she used to be, so once she's strayed far enough from where the path was last found in full, it's found from `start` again.
+internal PathCoordinatesNode* splice_lucia_flow_field(State* state, PathCoordinatesNode* path, vi2 start)
+{
+	constexpr f32 SPLICED_DISTANCE_BUDGET = 8.0f;
+
+	memory_arena_checkpoint(&state->transient_arena);
+
+	i32 candidate_count = 1;
+	for (PathCoordinatesNode* node = path; node; node = node->next_node)
+	{
+		candidate_count += 1;
+	}
+
+	vi2* candidates = memory_arena_allocate<vi2>(&state->transient_arena, candidate_count);
+	candidates[0] = start;
+	{
+		i32 candidate_index = 1;
+		for (PathCoordinatesNode* node = path; node; node = node->next_node)
+		{
+			candidates[candidate_index] = node->coordinates;
+			candidate_index += 1;
+		}
+	}
+
+	if (state->game.monster_path_spliced_distance < SPLICED_DISTANCE_BUDGET)
+	{
+		i32 nearest_candidate = settle_lucia_flow_field(state, candidates, candidate_count);
+		if (nearest_candidate > 0)
+		{
+			PathCoordinatesNode* splice_node = path;
+			FOR_RANGE(nearest_candidate - 1)
+			{
+				splice_node = splice_node->next_node;
+			}
+
+			while (splice_node->next_node)
+			{
+				splice_node->next_node = deallocate_path_coordinates_node(state, splice_node->next_node);
+			}
+
+			splice_node->next_node = deallocate_path_coordinates_node(state, follow_lucia_flow_field(state, splice_node->coordinates)); // @NOTE@ The followed path starts at `splice_node` itself.
+
+			state->game.monster_path_spliced_distance += state->game.lucia_flow_distances[splice_node->coordinates.y * MAP_DIM + splice_node->coordinates.x];
+			return path;
+		}
+	}
+
+	while (path)
+	{
+		path = deallocate_path_coordinates_node(state, path);
+	}
+
+	state->game.monster_path_spliced_distance = 0.0f;
+	return follow_lucia_flow_field(state, start);
+}
+
+internal PathCoordinatesNode* path_find(State* state, vi2 start, vi2 end)
+{
+	PROFILER_scope("path_find");
+
+	memory_arena_checkpoint(&state->transient_arena);
+
+	// @NOTE@ Ties are broken towards the most recently pushed or decreased vertex.
+	struct PathHeapEntry
+	{
+		f32 estimated_length;
+		u32 order;
+		vi2 coordinates;
+	};
+
+	state->game.path_generation += 1;
+	if (state->game.path_generation == 0)
+	{
+		memset(state->game.path_vertices, 0, sizeof(state->game.path_vertices));
+		state->game.path_generation = 1;
+	}
+
+	aliasing       path_vertices   = state->game.path_vertices;
+	u32            generation      = state->game.path_generation;
+	PathHeapEntry* path_heap       = memory_arena_allocate<PathHeapEntry>(&state->transient_arena, MAP_DIM * 2 * MAP_DIM);
+	i32            path_heap_count = 0;
+	u32            path_heap_order = 0;
+
+	lambda precedes =
+		[&](i32 i, i32 j)
+		{
+			return
+				path_heap[i].estimated_length < path_heap[j].estimated_length ||
+				path_heap[i].estimated_length == path_heap[j].estimated_length && path_heap[i].order > path_heap[j].order;
+		};
+
+	lambda swap_entries =
+		[&](i32 i, i32 j)
+		{
+			PathHeapEntry entry = path_heap[i];
+			path_heap[i] = path_heap[j];
+			path_heap[j] = entry;
+			path_vertices[path_heap[i].coordinates.y][path_heap[i].coordinates.x].heap_index = i;
+			path_vertices[path_heap[j].coordinates.y][path_heap[j].coordinates.x].heap_index = j;
+		};
+
+	lambda sift_up =
+		[&](i32 i)
+		{
+			while (i > 0 && precedes(i, (i - 1) / 2))
+			{
+				swap_entries(i, (i - 1) / 2);
+				i = (i - 1) / 2;
+			}
+		};
+
+	lambda sift_down =
+		[&](i32 i)
+		{
+			while (true)
+			{
+				i32 first = i;
+				FOR_RANGE(child, i * 2 + 1, min(i * 2 + 3, path_heap_count))
 				{
-					if (mask & (1 << i))
+					if (precedes(child, first))
 					{
-						RenderScanNode** post_node = &render_scan_node;
-						while (*post_node && (*post_node)->distance < scalars[i])
-						{
-							post_node = &(*post_node)->next_node;
-						}
-
-						RenderScanNode* new_node = memory_arena_allocate<RenderScanNode>(&arena);
-						new_node->material   = material;
-						new_node->in_light   = state->game.monster_timeout == 0.0f && exists_clear_way(state, state->game.lucia_position.xy + ray_horizontal * scalars[i] * SHADER_INV_EPSILON, state->game.monster_position.xy);
-						new_node->starting_y = static_cast<i16>(VIEW_RES.y / 2.0f + HORT_TO_VERT_K / state->game.lucia_fov * (position.z - 0.5f * dimensions.y - state->game.lucia_position.z) / (scalars[i] + 0.1f));
-						new_node->ending_y   = static_cast<i16>(VIEW_RES.y / 2.0f + HORT_TO_VERT_K / state->game.lucia_fov * (position.z + 0.5f * dimensions.y - state->game.lucia_position.z) / (scalars[i] + 0.1f));
-						new_node->image      = image;
-						new_node->normal     = normal;
-						new_node->distance   = scalars[i];
-						new_node->portion    = portions[i];
-						new_node->next_node  = *post_node;
-						*post_node = new_node;
-						break;
+						first = child;
 					}
 				}
+
+				if (first == i)
+				{
+					break;
+				}
+
+				swap_entries(i, first);
+				i = first;
 			}
 		};
 
-#if DEBUG_DISABLE_SPRITES
-#else
-	if (state->game.monster_timeout == 0.0f)
+	// @NOTE@ Pushes the vertex into the heap, or moves it up to its new estimate if it's already in there.
+	lambda push =
+		[&](vi2 coordinates, f32 estimated_length)
+		{
+			PathVertex* vertex = &path_vertices[coordinates.y][coordinates.x];
+			if (vertex->heap_index == -1)
+			{
+				ASSERT(path_heap_count < MAP_DIM * 2 * MAP_DIM);
+				vertex->heap_index = path_heap_count;
+				path_heap_count   += 1;
+			}
+
+			path_heap[vertex->heap_index].estimated_length = estimated_length;
+			path_heap[vertex->heap_index].order            = path_heap_order;
+			path_heap[vertex->heap_index].coordinates      = coordinates;
+			path_heap_order += 1;
+
+			sift_up(vertex->heap_index);
+		};
+
+	lambda pop =
+		[&]()
+		{
+			vi2 coordinates = path_heap[0].coordinates;
+			swap_entries(0, path_heap_count - 1);
+			path_heap_count -= 1;
+			path_vertices[coordinates.y][coordinates.x].heap_index = -1;
+			sift_down(0);
+			return coordinates;
+		};
+
+	path_vertices[start.y][start.x].generation       = generation;
+	path_vertices[start.y][start.x].heap_index       = -1;
+	path_vertices[start.y][start.x].best_weight      = 0.0f;
+	path_vertices[start.y][start.x].prev_coordinates = { -1, -1 };
+	push(start, path_distance_function(start, end));
+
+	while (path_heap_count && path_heap[0].coordinates != end)
+	{
+		vi2 head_coordinates      = pop();
+		vi2 head_prev_coordinates = path_vertices[head_coordinates.y][head_coordinates.x].prev_coordinates;
+		i32 head_index            = head_coordinates.y * MAP_DIM + head_coordinates.x;
+
+		FOR_RANGE(i, state->game.path_edge_offsets[head_index], state->game.path_edge_offsets[head_index + 1])
+		{
+			i32 next_index       = state->game.path_edge_targets[i];
+			vi2 next_coordinates = { next_index % MAP_DIM, next_index / MAP_DIM };
+
+			if (next_coordinates == head_prev_coordinates)
+			{
+				continue;
+			}
+
+			f32         next_weight = path_vertices[head_coordinates.y][head_coordinates.x].best_weight + PATH_STEPS[state->game.path_edge_steps[i]].weight;
+			PathVertex* next_vertex = &path_vertices[next_coordinates.y][next_coordinates.x];
+
+			if (next_vertex->generation != generation)
+			{
+				next_vertex->generation = generation;
+				next_vertex->heap_index = -1;
+			}
+			else if (next_vertex->best_weight <= next_weight)
+			{
+				continue;
+			}
+
+			next_vertex->best_weight      = next_weight;
+			next_vertex->prev_coordinates = head_coordinates;
+			push(next_coordinates, next_weight + path_distance_function(next_coordinates, end));
+		}
+	}
+
+	PathCoordinatesNode* path = 0;
+
+	if (path_heap_count && path_heap[0].coordinates == end)
+	{
+		vi2 coordinates = end;
+		while (true)
+		{
+			PathCoordinatesNode* path_coordinates_node = allocate_path_coordinates_node(state);
+			path_coordinates_node->coordinates = coordinates;
+			path_coordinates_node->next_node   = path;
+			path = path_coordinates_node;
+
+			if (coordinates == start)
+			{
+				break;
+			}
+
+			coordinates = path_vertices[coordinates.y][coordinates.x].prev_coordinates;
+		}
+	}
+	else
+	{
+		ASSERT(false);
+	}
+
+	return path;
+}
+
+// @NOTE@ Plans on the cluster graph of `build_path_clusters` when `end` is past the clusters neighboring `start`'s, but only refines the way through the next
+// `PATH_REFINED_CLUSTER_COUNT` clusters with `path_find`. So the path can stop short of `end` at a transition, and it's up to the caller to find the rest from there later.
+// Maps whose cluster graph didn't fit (see `build_path_clusters`) are planned entirely with `path_find`.
+internal PathCoordinatesNode* path_find_hierarchical(State* state, vi2 start, vi2 end)
+{
+	PROFILER_scope("path_find_hierarchical");
+
+	memory_arena_checkpoint(&state->transient_arena);
+
+	i32 start_cluster_index = get_path_cluster_index(start);
+	i32 end_cluster_index   = get_path_cluster_index(end);
+
+	vi2 cluster_deltas =
+		{
+			mod(end_cluster_index % PATH_CLUSTERS_PER_SIDE - start_cluster_index % PATH_CLUSTERS_PER_SIDE + 1, PATH_CLUSTERS_PER_SIDE),
+			mod(end_cluster_index / PATH_CLUSTERS_PER_SIDE - start_cluster_index / PATH_CLUSTERS_PER_SIDE + 1, PATH_CLUSTERS_PER_SIDE)
+		};
+	if (cluster_deltas.x <= 2 && cluster_deltas.y <= 2 || !state->game.path_transition_count)
+	{
+		return path_find(state, start, end);
+	}
+
+	aliasing transition_vertices = state->game.path_transition_vertices;
+	aliasing cluster_offsets     = state->game.path_cluster_transition_offsets;
+	i32      goal_index          = state->game.path_transition_count; // @NOTE@ `end` itself, which the transitions of its cluster lead into.
+
+	lambda get_transition_coordinates =
+		[&](i32 transition_index)
+		{
+			return vi2 { transition_vertices[transition_index] % MAP_DIM, transition_vertices[transition_index] / MAP_DIM };
+		};
+
+	f32* start_distances = memory_arena_allocate<f32>(&state->transient_arena, PATH_CLUSTER_VERTEX_COUNT);
+	f32* end_distances   = memory_arena_allocate<f32>(&state->transient_arena, PATH_CLUSTER_VERTEX_COUNT);
+	search_path_cluster(state, start, false, start_distances);
+	search_path_cluster(state, end  , true , end_distances  );
+
+	f32* best_weights      = memory_arena_allocate<f32>(&state->transient_arena, goal_index + 1);
+	f32* estimated_lengths = memory_arena_allocate<f32>(&state->transient_arena, goal_index + 1);
+	i32* prev_indices      = memory_arena_allocate<i32>(&state->transient_arena, goal_index + 1);
+	i32* heap_slots        = memory_arena_allocate<i32>(&state->transient_arena, goal_index + 1); // @NOTE@ Where each transition is in `heap`, or -1 if it isn't in there.
+	i32* heap              = memory_arena_allocate<i32>(&state->transient_arena, goal_index + 1);
+	i32  heap_count        = 0;
+	FOR_RANGE(i, goal_index + 1)
+	{
+		best_weights[i] = INFINITY;
+		prev_indices[i] = -1;
+		heap_slots  [i] = -1;
+	}
+
+	lambda swap_entries =
+		[&](i32 i, i32 j)
+		{
+			i32 transition_index = heap[i];
+			heap[i] = heap[j];
+			heap[j] = transition_index;
+			heap_slots[heap[i]] = i;
+			heap_slots[heap[j]] = j;
+		};
+
+	lambda sift_up =
+		[&](i32 i)
+		{
+			while (i > 0 && estimated_lengths[heap[i]] < estimated_lengths[heap[(i - 1) / 2]])
+			{
+				swap_entries(i, (i - 1) / 2);
+				i = (i - 1) / 2;
+			}
+		};
+
+	lambda sift_down =
+		[&](i32 i)
+		{
+			while (true)
+			{
+				i32 first = i;
+				FOR_RANGE(child, i * 2 + 1, min(i * 2 + 3, heap_count))
+				{
+					if (estimated_lengths[heap[child]] < estimated_lengths[heap[first]])
+					{
+						first = child;
+					}
+				}
+
+				if (first == i)
+				{
+					break;
+				}
+
+				swap_entries(i, first);
+				i = first;
+			}
+		};
+
+	// @NOTE@ Pushes the transition into the heap, or moves it up if it's already in there, when the way through `prev_index` is shorter than the best one so far.
+	lambda push =
+		[&](i32 transition_index, f32 weight, i32 prev_index)
+		{
+			if (weight < best_weights[transition_index])
+			{
+				best_weights     [transition_index] = weight;
+				estimated_lengths[transition_index] = transition_index == goal_index ? weight : weight + path_distance_function(get_transition_coordinates(transition_index), end);
+				prev_indices     [transition_index] = prev_index;
+
+				if (heap_slots[transition_index] == -1)
+				{
+					heap_slots[transition_index] = heap_count;
+					heap[heap_count]             = transition_index;
+					heap_count                  += 1;
+				}
+
+				sift_up(heap_slots[transition_index]);
+			}
+		};
+
+	FOR_RANGE(i, cluster_offsets[start_cluster_index], cluster_offsets[start_cluster_index + 1])
+	{
+		push(i, start_distances[get_path_cluster_vertex_index(get_transition_coordinates(i))], -1);
+	}
+
+	while (heap_count && heap[0] != goal_index)
+	{
+		i32 head_index = heap[0];
+		swap_entries(0, heap_count - 1);
+		heap_count             -= 1;
+		heap_slots[head_index]  = -1;
+		sift_down(0);
+
+		vi2 head_coordinates = get_transition_coordinates(head_index);
+		if (get_path_cluster_index(head_coordinates) == end_cluster_index)
+		{
+			push(goal_index, best_weights[head_index] + end_distances[get_path_cluster_vertex_index(head_coordinates)], head_index);
+		}
+
+		FOR_RANGE(i, state->game.path_transition_edge_offsets[head_index], state->game.path_transition_edge_offsets[head_index + 1])
+		{
+			push(state->game.path_transition_edge_targets[i], best_weights[head_index] + state->game.path_transition_edge_weights[i], head_index);
+		}
+	}
+
+	if (!heap_count) // @NOTE@ Grouping the crossing edges into entrances shouldn't lose any way between clusters, but if it somehow did, the whole lattice still has it.
+	{
+		return path_find(state, start, end);
+	}
+
+	// @NOTE@ The transitions come out from `end` backwards, so they're listed first and then gone through from `start` until the way enters the `PATH_REFINED_CLUSTER_COUNT`-th cluster after `start`'s.
+	i32* transition_indices     = memory_arena_allocate<i32>(&state->transient_arena, goal_index);
+	i32  transition_index_count = 0;
+	for (i32 i = prev_indices[goal_index]; i != -1; i = prev_indices[i])
+	{
+		transition_indices[transition_index_count] = i;
+		transition_index_count += 1;
+	}
+
+	vi2 waypoint              = end;
+	i32 entered_cluster_count = 0;
+	i32 cluster_index         = start_cluster_index;
+	for (i32 i = transition_index_count - 1; i >= 0; i -= 1)
+	{
+		vi2 coordinates = get_transition_coordinates(transition_indices[i]);
+		if (get_path_cluster_index(coordinates) != cluster_index)
+		{
+			cluster_index          = get_path_cluster_index(coordinates);
+			entered_cluster_count += 1;
+
+			if (entered_cluster_count == PATH_REFINED_CLUSTER_COUNT)
+			{
+				waypoint = coordinates;
+				break;
+			}
+		}
+	}
+
+	return path_find(state, start, waypoint);
+}
+
+// @NOTE@ The lighting terms of `shader`, shared with `render_floor_ceiling_span`, which lights four columns of a row at once. `z` is the fragment's height.
+internal f32 get_ambient_light(State* state, Material material, f32 z, f32 distance)
+{
+	f32 ambient_light =
+		0.5f * fast_rcp(square(distance) / 9.0f / (square(state->game.night_vision_goggles_activation) * 32.0f + 1.0f + (material == Material::item ? 4.0f : 0.0f) + state->game.interpolated_eye_drops_activation * 3.0f) + 1.0f)
+			+ lerp(0.6f, 1.3f, z / state->game.percieved_wall_height) * (0.5f - 4.0f * cube(0.5f - state->game.ceiling_lights_keytime));
+
+	if (material == Material::item)
+	{
+		ambient_light += 0.1f;
+	}
+
+	return ambient_light;
+}
+
+// @NOTE@ `flashlight_dot` is the eye ray dotted with the flashlight's, and `normal_dot` with the fragment's normal.
+template <typename F32XN>
+internal F32XN get_flashlight_light(State* state, F32XN flashlight_dot, f32 normal_dot, f32 distance)
+{
+	return
+		(1.0f + fast_pow(square(normal_dot), 64) * square(flashlight_dot) * 0.8f)
+			* clamp((flashlight_dot - FLASHLIGHT_OUTER_CUTOFF) / (FLASHLIGHT_INNER_CUTOFF - FLASHLIGHT_OUTER_CUTOFF), 0.0f, 1.0f)
+			* fast_rcp(square(distance) * 0.1f + 7.0f)
+			* 6.0f
+			* state->game.flashlight_activation;
+}
+
+// @NOTE@ For a fragment in the monster's light; `frag_ray` runs from the fragment to the monster, and `normal_dot` is it dotted with the fragment's normal.
+template <typename F32XN>
+internal F32XN get_fire_light(F32XN frag_ray_norm_sq, f32 normal_dot)
+{
+	F32XN frag_ray_inv_norm = fast_rsqrt(frag_ray_norm_sq);
+	return
+		32.0f
+		* square(clamp(fast_rcp(frag_ray_norm_sq * frag_ray_inv_norm + 0.1f), 0.0f, 1.0f))
+		* fabsf(normal_dot) * frag_ray_inv_norm;
+}
+
+template <typename VF3XN, typename F32XN>
+internal VF3XN apply_light(State* state, VF3XN color, f32 ambient_light, F32XN flashlight_light, F32XN fire_light)
+{
+	f32 max_color = square(1.0f - state->game.lucia_dying_keytime);
+	return VF3XN
+		{
+			clamp((color.x * (AMBIENT_COLOR.x * ambient_light + FLASHLIGHT_COLOR.x * flashlight_light + FIRE_COLOR.x * fire_light)), 0.0f, max_color),
+			clamp((color.y * (AMBIENT_COLOR.y * ambient_light + FLASHLIGHT_COLOR.y * flashlight_light + FIRE_COLOR.y * fire_light)), 0.0f, max_color),
+			clamp((color.z * (AMBIENT_COLOR.z * ambient_light + FLASHLIGHT_COLOR.z * flashlight_light + FIRE_COLOR.z * fire_light)), 0.0f, max_color)
+		};
+}
+
+internal vf3 shader(State* state, vf3 color, Material material, bool32 in_light, vf3 ray, vf3 normal, f32 distance)
+{
+#if DEBUG_DISABLE_SHADER
+	return color;
+#else
+	f32 ambient_light    = get_ambient_light(state, material, state->game.lucia_position.z + ray.z * distance, distance);
+	f32 flashlight_light = get_flashlight_light(state, dot(ray, state->game.flashlight_ray), dot(ray, normal), distance);
+
+	f32 fire_light;
+	if (in_light)
+	{
+		if (material == Material::monster)
+		{
+			fire_light = 2.0f;
+		}
+		else if (material == Material::fire)
+		{
+			fire_light = 3.0f;
+		}
+		else
+		{
+			vf3 frag_position = state->game.lucia_position + ray * distance;
+			vf3 frag_ray      = vxx(ray_to_closest(frag_position.xy, state->game.monster_position.xy), state->game.monster_position.z - frag_position.z);
+			fire_light = get_fire_light(norm_sq(frag_ray), dot(frag_ray, normal));
+		}
+	}
+	else
+	{
+		fire_light = 0.0f;
+	}
+
+	return apply_light(state, color, ambient_light, flashlight_light, fire_light);
+#endif
+}
+
+// @NOTE@ Projects every sprite onto the columns it could cover once per frame so a column only intersects the sprites that are actually in front of it.
+// Only the copy of a sprite on the map closest to Lucia is projected, and sprites outside the view cone or behind the walls of every column they span are dropped.
+internal void compute_render_sprites(State* state)
+{
+	PROFILER_scope("compute_render_sprites");
+
+	state->game.render_sprite_count = 0;
+
+	lambda add =
+		[&](Material material, Image image, vf3 position, vf2 normal, vf2 dimensions)
+		{
+			vf2 ray   = ray_to_closest(state->game.lucia_position.xy, position.xy);
+			vf2 start = state->game.lucia_position.xy + ray + vf2 {  normal.y, -normal.x } * dimensions.x / 2.0f;
+			vf2 end   = state->game.lucia_position.xy + ray + vf2 { -normal.y,  normal.x } * dimensions.x / 2.0f;
+
+			f32 start_angle = mod(atan2(start - state->game.lucia_position.xy) - state->game.lucia_angle + TAU / 2.0f, TAU) - TAU / 2.0f;
+			f32 sweep       = mod(atan2(end - state->game.lucia_position.xy) - atan2(start - state->game.lucia_position.xy) + TAU / 2.0f, TAU) - TAU / 2.0f;
+			i32 starting_x  = VIEW_RES.x;
+			i32 ending_x    = 0;
+
+			if (fabsf(sweep) > TAU / 2.0f - 0.01f) // @NOTE@ Lucia is about on the sprite, so it could be anywhere in the view.
+			{
+				starting_x = 0;
+				ending_x   = VIEW_RES.x;
+			}
+			else
+			{
+				FOR_RANGE(i, -1, 2) // @NOTE@ The angles may have wrapped around behind Lucia.
+				{
+					f32 low  = max(start_angle + min(sweep, 0.0f) + i * TAU, -state->game.lucia_fov / 2.0f);
+					f32 high = min(start_angle + max(sweep, 0.0f) + i * TAU,  state->game.lucia_fov / 2.0f);
+					if (low <= high)
+					{
+						starting_x = min(starting_x, static_cast<i32>(floorf((0.5f - high / state->game.lucia_fov) * VIEW_RES.x)) - 1);
+						ending_x   = max(ending_x  , static_cast<i32>(ceilf ((0.5f - low  / state->game.lucia_fov) * VIEW_RES.x)) + 1);
+					}
+				}
+
+				starting_x = max(starting_x, 0);
+				ending_x   = min(ending_x  , VIEW_RES.x);
+			}
+
+			// @NOTE@ No point of the sprite is nearer than `nearest_distance`, so the columns at either end of its span that hit a wall before then are trimmed off.
+			f32 nearest_distance = norm(ray) - dimensions.x / 2.0f;
+			while (starting_x < ending_x && +state->game.render_view_columns[starting_x].wall_side.voxel && state->game.render_view_columns[starting_x].wall_distance < nearest_distance)
+			{
+				starting_x += 1;
+			}
+			while (starting_x < ending_x && +state->game.render_view_columns[ending_x - 1].wall_side.voxel && state->game.render_view_columns[ending_x - 1].wall_distance < nearest_distance)
+			{
+				ending_x -= 1;
+			}
+
+			if (starting_x < ending_x)
+			{
+				ASSERT(state->game.render_sprite_count < RENDER_SPRITE_CAPACITY);
+				RenderSprite* sprite = &state->game.render_sprites[state->game.render_sprite_count];
+				sprite->material    = material;
+				sprite->image       = image;
+				sprite->start       = start;
+				sprite->end         = end;
+				sprite->normal      = normal;
+				sprite->z           = position.z;
+				sprite->height      = dimensions.y;
+				sprite->distance_sq = norm_sq(ray);
+				sprite->starting_x  = static_cast<i16>(starting_x);
+				sprite->ending_x    = static_cast<i16>(ending_x);
+				state->game.render_sprite_count += 1;
+			}
+		};
+
+#if DEBUG_DISABLE_SPRITES
+#else
+	if (state->game.monster_timeout == 0.0f)
+	{
+		add(Material::monster, get_image_of_frame(&state->game.animated_sprite.monster), state->game.monster_position, state->game.monster_normal, { 1.0f, 1.0f });
+
+		FOR_RANGE(i, MONSTER_FIRE_COUNT)
+		{
+			vf3 fire_position = state->game.monster_position + vxx(polar(state->time + static_cast<f32>(i) / MONSTER_FIRE_COUNT * TAU), 0.0f);
+			if (is_in_monster_light(state, fire_position.xy))
+			{
+				add(Material::fire, get_image_of_frame(&state->game.animated_sprite.fire), fire_position, normalize(ray_to_closest(state->game.monster_position.xy, state->game.lucia_position.xy)), { 1.0f, 1.0f });
+			}
+		}
+	}
+
+	if (state->game.hand_on_state != HandOnState::null)
+	{
+		add(Material::hand, state->game.texture_sprite.hand.image, state->game.hand_position, normalize(ray_to_closest(state->game.hand_position.xy, state->game.lucia_position.xy)), { 0.1f, 0.1f });
+	}
+
+	FOR_ELEMS(it, state->game.item_buffer, state->game.item_count)
+	{
+		add(Material::item, state->game.texture_sprite.default_items[+it->type - +ItemType::ITEM_START].image, it->position, it->normal, { 0.5f, 0.5f });
+	}
+#endif
+
+	std::sort
+	(
+		state->game.render_sprites,
+		state->game.render_sprites + state->game.render_sprite_count,
+		[](const RenderSprite& a, const RenderSprite& b) { return a.distance_sq < b.distance_sq; }
+	);
+
+	// @NOTE@ Counts the sprites of each column first; the farthest are dropped from crowded columns since they would be hidden anyways.
+	u16* offsets = state->game.render_sprite_column_offsets;
+	FOR_RANGE(i, VIEW_RES.x + 1)
+	{
+		offsets[i] = 0;
+	}
+
+	FOR_ELEMS(sprite, state->game.render_sprites, state->game.render_sprite_count)
+	{
+		FOR_RANGE(x, sprite->starting_x, sprite->ending_x)
+		{
+			offsets[x + 1] = static_cast<u16>(min(offsets[x + 1] + 1, RENDER_SPRITES_PER_COLUMN));
+		}
+	}
+
+	FOR_RANGE(x, VIEW_RES.x)
+	{
+		offsets[x + 1] += offsets[x];
+	}
+
+	u16 cursors[VIEW_RES.x];
+	memcpy(cursors, offsets, sizeof(cursors));
+
+	FOR_ELEMS(sprite, state->game.render_sprites, state->game.render_sprite_count)
+	{
+		FOR_RANGE(x, sprite->starting_x, sprite->ending_x)
+		{
+			if (cursors[x] < offsets[x + 1])
+			{
+				state->game.render_sprite_column_indices[cursors[x]] = static_cast<u8>(sprite_index);
+				cursors[x] += 1;
+			}
+		}
+	}
+}
+
+// @NOTE@ The row rays only depend on `lucia_fov`, so they're rebuilt only when it changes. The column rays are rotated from one column to the next instead of
+// calling `polar` per column; the rounding error accumulated over the view is in the order of 1e-5 radians, far less than the ~0.008 radians a column spans.
+internal void compute_view_rays(State* state)
+{
+	if (state->game.render_row_ray_fov != state->game.lucia_fov)
+	{
+		state->game.render_row_ray_fov = state->game.lucia_fov;
+
+		FOR_RANGE(y, VIEW_RES.y)
+		{
+			f32 ray_z_scale = (y - VIEW_RES.y / 2.0f) * state->game.lucia_fov / HORT_TO_VERT_K;
+			state->game.render_row_ray_xys[y] = 1.0f / sqrtf(1.0f + square(ray_z_scale));
+			state->game.render_row_ray_zs [y] = ray_z_scale * state->game.render_row_ray_xys[y];
+		}
+	}
+
+	vf2 step = polar(-state->game.lucia_fov / VIEW_RES.x);
+	vf2 ray  = polar(state->game.lucia_angle + 0.5f * state->game.lucia_fov);
+	FOR_ELEMS(it, state->game.render_column_rays)
+	{
+		*it = ray;
+		ray = { ray.x * step.x - ray.y * step.y, ray.x * step.y + ray.y * step.x };
+	}
+}
+
+// @NOTE@ Fills in the rest of the column once the cast found the wall side it hit.
+internal void finish_view_column(State* state, ViewColumn* column, i32 wall_voxel_index, i32 wall_side_index)
+{
+	aliasing ray_horizontal             = column->ray_horizontal;
+	aliasing ray_casted_wall_side       = column->wall_side;
+	aliasing wall_distance              = column->wall_distance;
+	aliasing wall_portion               = column->wall_portion;
+	aliasing wall_starting_y            = column->wall_starting_y;
+	aliasing wall_ending_y              = column->wall_ending_y;
+	aliasing wall_overlay               = column->wall_overlay;
+	aliasing wall_overlay_uv_position   = column->wall_overlay_uv_position;
+	aliasing wall_overlay_uv_dimensions = column->wall_overlay_uv_dimensions;
+
+	ray_casted_wall_side.coordinates.x = mod(ray_casted_wall_side.coordinates.x, MAP_DIM);
+	ray_casted_wall_side.coordinates.y = mod(ray_casted_wall_side.coordinates.y, MAP_DIM);
+
+	wall_starting_y = static_cast<i32>(VIEW_RES.y / 2.0f - HORT_TO_VERT_K / state->game.lucia_fov * state->game.lucia_position.z / (wall_distance + lerp(0.01f, 1.0f, state->game.interpolated_pills_effect_activations[0])));
+	wall_ending_y   = static_cast<i32>(VIEW_RES.y / 2.0f + HORT_TO_VERT_K / state->game.lucia_fov * (state->game.percieved_wall_height - state->game.lucia_position.z) / (wall_distance + lerp(0.01f, 3.0f, state->game.interpolated_pills_effect_activations[0])));
+
+	WallDecoration decoration = state->game.wall_side_decorations[ray_casted_wall_side.coordinates.y][ray_casted_wall_side.coordinates.x][wall_voxel_index][wall_side_index];
+	if (decoration != WallDecoration::none)
+	{
+		wall_overlay               = get_wall_decoration_image(state, decoration);
+		wall_overlay_uv_position   = WALL_DECORATION_DATA[+decoration].uv_position;
+		wall_overlay_uv_dimensions = WALL_DECORATION_DATA[+decoration].uv_dimensions;
+	}
+
+	if (wall_overlay && !IN_RANGE(wall_portion, wall_overlay_uv_position.x, wall_overlay_uv_position.x + wall_overlay_uv_dimensions.x))
+	{
+		wall_overlay = 0;
+	}
+}
+
+// @NOTE@ Neighboring columns nearly always step through the same cells and hit the same wall, so up to four of them are cast as a packet.
+// On every step, the columns still casting are grouped by the cell they're in, and each group fetches the cell once and tests its voxels against all of its rays at once.
+// Columns that drift apart just end up in different groups (and merge back if they meet again), so every column still walks the exact cells it would've walked alone.
+internal void cast_view_columns(ViewColumn* columns, State* state, i32 start_x, i32 count)
+{
+	ASSERT(IN_RANGE(count, 1, 5));
+
+	vf2 rays              [4];
+	vi2 steps             [4];
+	vf2 t_deltas          [4];
+	vf2 t_maxes           [4];
+	i32 wall_voxel_indices[4];
+	i32 wall_side_indices [4];
+
+	FOR_RANGE(i, 4)
+	{
+		rays[i] = state->game.render_column_rays[start_x + min(i, count - 1)]; // @NOTE@ Lanes past `count` repeat the last column and are masked out.
+	}
+
+	FOR_RANGE(i, count)
+	{
+		ViewColumn* column = &columns[i];
+		column->ray_horizontal             = rays[i];
+		column->wall_side                  = {};
+		column->wall_distance              = NAN;
+		column->wall_portion               = NAN;
+		column->wall_starting_y            = 0;
+		column->wall_ending_y              = 0;
+		column->wall_overlay               = 0;
+		column->wall_overlay_uv_position   = { NAN, NAN };
+		column->wall_overlay_uv_dimensions = { NAN, NAN };
+
+		steps   [i] = { sign(rays[i].x), sign(rays[i].y) };
+		t_deltas[i] = vf2 { steps[i].x / rays[i].x, steps[i].y / rays[i].y } * WALL_SPACING;
+		t_maxes [i] =
+			{
+				(floorf(state->game.lucia_position.x / WALL_SPACING + (rays[i].x >= 0.0f)) * WALL_SPACING - state->game.lucia_position.x) / rays[i].x,
+				(floorf(state->game.lucia_position.y / WALL_SPACING + (rays[i].y >= 0.0f)) * WALL_SPACING - state->game.lucia_position.y) / rays[i].y
+			};
+
+		column->wall_side.coordinates =
+			{
+				static_cast<i32>(floorf(state->game.lucia_position.x / WALL_SPACING)),
+				static_cast<i32>(floorf(state->game.lucia_position.y / WALL_SPACING))
+			};
+
+		wall_voxel_indices[i] = -1;
+		wall_side_indices [i] = -1;
+	}
+
+	// @NOTE@ Every cell within `clearance - 1` of an empty one is empty too, so the DDA jumps straight to the crossing that leaves that square,
+	// along with the crossings of the other axis that it would've stepped through before then (ties go to y like below).
+	lambda skip_clearance =
+		[&](i32 i, i32 clearance)
+		{
+			aliasing coordinates = columns[i].wall_side.coordinates;
+			aliasing step        = steps[i];
+			aliasing t_delta     = t_deltas[i];
+			aliasing t_max       = t_maxes[i];
+
+			f32 x_exit = step.x ? t_max.x + (clearance - 1) * t_delta.x : INFINITY;
+			f32 y_exit = step.y ? t_max.y + (clearance - 1) * t_delta.y : INFINITY;
+
+			if (x_exit < y_exit)
+			{
+				i32 y_crossings = step.y && t_max.y <= x_exit ? static_cast<i32>((x_exit - t_max.y) / t_delta.y) + 1 : 0;
+				t_max.x        = x_exit + t_delta.x;
+				t_max.y       += y_crossings * t_delta.y;
+				coordinates.x += clearance * step.x;
+				coordinates.y += y_crossings * step.y;
+			}
+			else
+			{
+				i32 x_crossings = step.x && t_max.x < y_exit ? static_cast<i32>(ceilf((y_exit - t_max.x) / t_delta.x)) : 0;
+				t_max.x       += x_crossings * t_delta.x;
+				t_max.y        = y_exit + t_delta.y;
+				coordinates.x += x_crossings * step.x;
+				coordinates.y += clearance * step.y;
+			}
+		};
+
+	vf2x4 ray_packet    = load_vf2x4(rays);
+	i32   casting_lanes = (1 << count) - 1;
+
+	FOR_RANGE(MAP_DIM * MAP_DIM)
+	{
+		if (!casting_lanes)
+		{
+			break;
+		}
+
+		i32 ungrouped_lanes = casting_lanes;
+		FOR_RANGE(leader, count)
+		{
+			if (!(ungrouped_lanes & (1 << leader)))
+			{
+				continue;
+			}
+
+			vi2 coordinates = columns[leader].wall_side.coordinates;
+			i32 group_lanes = 0;
+			FOR_RANGE(i, leader, count)
+			{
+				if ((ungrouped_lanes & (1 << i)) && columns[i].wall_side.coordinates == coordinates)
+				{
+					group_lanes |= 1 << i;
+				}
+			}
+			ungrouped_lanes &= ~group_lanes;
+
+			vi2       wrapped_coordinates = { mod(coordinates.x, MAP_DIM), mod(coordinates.y, MAP_DIM) };
+			WallVoxel voxels              = state->game.wall_voxels[wrapped_coordinates.y][wrapped_coordinates.x];
+
+			if (!+voxels)
+			{
+				i32 clearance = state->game.wall_clearances[wrapped_coordinates.y][wrapped_coordinates.x];
+				FOR_RANGE(i, leader, count)
+				{
+					if (group_lanes & (1 << i))
+					{
+						skip_clearance(i, clearance);
+					}
+				}
+
+				continue;
+			}
+
+			FOR_ELEMS(voxel_data, WALL_VOXEL_DATA)
+			{
+				if (+(voxels & voxel_data->voxel))
+				{
+					f32x4    distances;
+					f32x4    portions;
+					mask32x4 cast_mask =
+						ray_cast_line
+						(
+							&distances,
+							&portions,
+							state->game.lucia_position.xy,
+							ray_packet,
+							(coordinates + voxel_data->start) * WALL_SPACING,
+							(coordinates + voxel_data->end  ) * WALL_SPACING
+						);
+					i32 cast_lanes    = movemask(cast_mask & (splat4(0.0f) <= portions) & (portions <= splat4(1.0f))) & group_lanes;
+					i32 flipped_lanes = movemask(dot(ray_packet, vf2x4 { splat4(voxel_data->normal.x), splat4(voxel_data->normal.y) }) > splat4(0.0f));
+
+					FOR_RANGE(i, leader, count)
+					{
+						if (cast_lanes & (1 << i))
+						{
+							ViewColumn* column   = &columns[i];
+							f32         distance = get(distances, i);
+							if (!+column->wall_side.voxel || distance < column->wall_distance)
+							{
+								column->wall_side.normal = voxel_data->normal;
+								column->wall_side.voxel  = voxel_data->voxel;
+								column->wall_distance    = distance;
+								column->wall_portion     = get(portions, i);
+								wall_voxel_indices[i]    = voxel_data_index;
+								wall_side_indices [i]    = 0;
+
+								if (flipped_lanes & (1 << i))
+								{
+									column->wall_side.normal *= -1.0f;
+									column->wall_portion      = 1.0f - column->wall_portion;
+									wall_side_indices[i]      = 1;
+								}
+							}
+						}
+					}
+				}
+			}
+
+			FOR_RANGE(i, leader, count)
+			{
+				if (group_lanes & (1 << i))
+				{
+					if (+columns[i].wall_side.voxel)
+					{
+						finish_view_column(state, &columns[i], wall_voxel_indices[i], wall_side_indices[i]);
+						casting_lanes &= ~(1 << i);
+					}
+					else if (t_maxes[i].x < t_maxes[i].y)
+					{
+						t_maxes[i].x                       += t_deltas[i].x;
+						columns[i].wall_side.coordinates.x += steps[i].x;
+					}
+					else
+					{
+						t_maxes[i].y                       += t_deltas[i].y;
+						columns[i].wall_side.coordinates.y += steps[i].y;
+					}
+				}
+			}
+		}
+	}
+}
+
+// @NOTE@ Packs the colors of four neighboring columns and stores the ones that are in `mask`.
+internal void store_view_pixels(u32* pixel, i32 mask, __m128 m_r, __m128 m_g, __m128 m_b)
+{
+	__m128i mi_byte_mask = _mm_set1_epi32(0xFF);
+	__m128i mi_pixels    =
+		_mm_or_si128
+		(
+			_mm_or_si128
+			(
+				_mm_slli_epi32(_mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(m_r, m_255)), mi_byte_mask), 24),
+				_mm_slli_epi32(_mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(m_g, m_255)), mi_byte_mask), 16)
+			),
+			_mm_or_si128
+			(
+				_mm_slli_epi32(_mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(m_b, m_255)), mi_byte_mask),  8),
+				mi_byte_mask
+			)
+		);
+
+	u32 pixels[4];
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(pixels), mi_pixels);
+
+	FOR_RANGE(i, 4)
+	{
+		if (mask & (1 << i))
+		{
+			pixel[i * VIEW_RES.y] = pixels[i];
+		}
+	}
+}
+
+internal void render_vertical_scan_line(u32* vertical_scan_line, State* state, ViewColumn* column, i32 x, u64* stage_counters)
+{
+	u64 stage_counter = SDL_GetPerformanceCounter();
+
+	aliasing ray_horizontal             = column->ray_horizontal;
+	aliasing ray_casted_wall_side       = column->wall_side;
+	aliasing wall_distance              = column->wall_distance;
+	aliasing wall_portion               = column->wall_portion;
+	aliasing wall_starting_y            = column->wall_starting_y;
+	aliasing wall_ending_y              = column->wall_ending_y;
+	aliasing wall_overlay               = column->wall_overlay;
+	aliasing wall_overlay_uv_position   = column->wall_overlay_uv_position;
+	aliasing wall_overlay_uv_dimensions = column->wall_overlay_uv_dimensions;
+
+	constexpr f32 SHADER_INV_EPSILON = 0.9f;
+
+	struct RenderScanHit
+	{
+		RenderSprite* sprite;
+		bool8         in_light;
+		i16           starting_y;
+		i16           ending_y;
+		f32           distance;
+		f32           portion;
+	};
+
+	RenderScanHit scan_hits[RENDER_SPRITES_PER_COLUMN];
+	i32           scan_hit_count = 0;
+	f32           max_scalar     = +ray_casted_wall_side.voxel ? wall_distance : INFINITY;
+
+	FOR_RANGE(i, state->game.render_sprite_column_offsets[x], state->game.render_sprite_column_offsets[x + 1])
+	{
+		RenderSprite* sprite         = &state->game.render_sprites[state->game.render_sprite_column_indices[i]];
+		vf2           start_to_end   = sprite->end - sprite->start;
+		vf2           start_to_lucia = state->game.lucia_position.xy - sprite->start;
+		f32           det            = ray_horizontal.x * start_to_end.y - ray_horizontal.y * start_to_end.x;
+		f32           scalar         = (start_to_lucia.y * start_to_end.x   - start_to_lucia.x * start_to_end.y  ) / det;
+		f32           portion        = (start_to_lucia.y * ray_horizontal.x - start_to_lucia.x * ray_horizontal.y) / det;
+
+		if (IN_RANGE(scalar, 0.0f, max_scalar) && IN_RANGE(portion, 0.0f, 1.0f))
+		{
+			RenderScanHit* hit = &scan_hits[scan_hit_count];
+			hit->sprite     = sprite;
+			hit->in_light   = state->game.monster_timeout == 0.0f && is_in_monster_light(state, state->game.lucia_position.xy + ray_horizontal * scalar * SHADER_INV_EPSILON);
+			hit->starting_y = static_cast<i16>(VIEW_RES.y / 2.0f + HORT_TO_VERT_K / state->game.lucia_fov * (sprite->z - 0.5f * sprite->height - state->game.lucia_position.z) / (scalar + 0.1f));
+			hit->ending_y   = static_cast<i16>(VIEW_RES.y / 2.0f + HORT_TO_VERT_K / state->game.lucia_fov * (sprite->z + 0.5f * sprite->height - state->game.lucia_position.z) / (scalar + 0.1f));
+			hit->distance   = scalar;
+			hit->portion    = portion;
+			scan_hit_count += 1;
+		}
+	}
+
+	// @NOTE@ Floor and ceiling were already shaded by `render_floor_ceiling_span`, so only the rows with walls or sprites are visited.
+	i32 starting_y = clamp(wall_starting_y, 0, VIEW_RES.y);
+	i32 ending_y   = clamp(wall_ending_y  , 0, VIEW_RES.y);
+	FOR_ELEMS(hit, scan_hits, scan_hit_count)
+	{
+		starting_y = min(starting_y, max(static_cast<i32>(hit->starting_y), 0));
+		ending_y   = max(ending_y  , min(static_cast<i32>(hit->ending_y  ), VIEW_RES.y));
+	}
+
+	{
+		u64 counter = SDL_GetPerformanceCounter();
+		stage_counters[+RenderStage::sprites] += counter - stage_counter;
+		stage_counter = counter;
+	}
+
+	// @NOTE@ Worked out here rather than in the cast since the render threads cast while the main thread is still building `monster_light_depths`.
+	bool32 wall_in_light =
+		+ray_casted_wall_side.voxel
+			&& state->game.monster_timeout == 0.0f
+			&& dot(ray_to_closest(state->game.lucia_position.xy + ray_horizontal * wall_distance, state->game.monster_position.xy), ray_casted_wall_side.normal) > 0.0f
+			&& is_in_monster_light(state, state->game.lucia_position.xy + ray_horizontal * wall_distance * 0.99f);
+
+	lambda get_wall_level =
+		[&](f32 distance, vf3 ray)
+		{
+			#if DEBUG_DISABLE_MIPMAPPING
+			return 0.0f;
+			#else
+			return (distance / 4.0f + state->game.mipmap.wall.level_count * square(1.0f - fabsf(dot(ray, vxx(ray_casted_wall_side.normal, 0.0f))))) * (1.0f - state->game.interpolated_eye_drops_activation);
+			#endif
+		};
+
+	vf2 wall_uv_rotation = fast_polar(square(state->game.interpolated_pills_effect_activations[0] * 8.0f) / 4.0f);
+	f32 wall_uv_shift    = fast_polar(state->game.interpolated_pills_effect_activations[0]).y;
+	f32 wall_inv_height  = 1.0f / (wall_ending_y - wall_starting_y);
+	i32 wall_first_y     = clamp(wall_starting_y, 0, VIEW_RES.y);
+	i32 wall_last_y      = clamp(wall_ending_y  , 0, VIEW_RES.y) - 1;
+
+	// @NOTE@ Without the pills distorting it, the wall of the column runs straight down a column of each mipmap level, so the texels are stepped through
+	// in 16.16 from the first visible row with the level picked once at the middle visible row.
+	bool32 wall_stepped =
+		wall_first_y <= wall_last_y &&
+		state->game.interpolated_pills_effect_activations[0] == 0.0f &&
+		state->game.interpolated_pills_effect_activations[1] == 0.0f &&
+		state->game.interpolated_pills_effect_activations[2] == 0.0f;
+	RGBA* wall_texel_columns[2];
+	i32   wall_texel_starts [2];
+	i32   wall_texel_steps  [2];
+	i32   wall_texel_heights[2];
+	u32   wall_level_t = 0;
+	if (wall_stepped)
+	{
+		i32 middle_y  = (wall_first_y + wall_last_y) / 2;
+		f32 y_portion = (middle_y - wall_starting_y) * wall_inv_height;
+		f32 level     =
+			get_wall_level
+			(
+				sqrtf(square(wall_distance) + square(y_portion * state->game.percieved_wall_height - state->game.lucia_position.z)),
+				{ ray_horizontal.x * state->game.render_row_ray_xys[middle_y], ray_horizontal.y * state->game.render_row_ray_xys[middle_y], state->game.render_row_ray_zs[middle_y] }
+			);
+		i32 level_index = static_cast<i32>(clamp(level, 0.0f, state->game.mipmap.wall.level_count - 1.0f));
+
+		if (IN_RANGE(level, 0.0f, state->game.mipmap.wall.level_count - 1.0f))
+		{
+			wall_level_t = static_cast<u32>((level - level_index) * 256.0f);
+		}
+
+		FOR_RANGE(i, 2)
+		{
+			wall_texel_columns[i] = get_mipmap_column(&state->game.mipmap.wall, min(level_index + i, state->game.mipmap.wall.level_count - 1), mod(wall_portion, 1.0f), &wall_texel_heights[i]);
+			wall_texel_starts [i] = static_cast<i32>((wall_texel_heights[i] - 1.0f) * (1.0f - (wall_first_y - wall_starting_y) * wall_inv_height) * 65536.0f + 0.5f);
+			wall_texel_steps  [i] = static_cast<i32>((wall_texel_heights[i] - 1.0f) * wall_inv_height * 65536.0f + 0.5f);
+		}
+	}
+
+	u32* current_pixel = vertical_scan_line + starting_y;
+	FOR_RANGE(y, starting_y, ending_y)
+	{
+		vf3 ray = { ray_horizontal.x * state->game.render_row_ray_xys[y], ray_horizontal.y * state->game.render_row_ray_xys[y], state->game.render_row_ray_zs[y] };
+
+		FOR_ELEMS(hit, scan_hits, scan_hit_count)
+		{
+			if (IN_RANGE(y, hit->starting_y, hit->ending_y) && IN_RANGE(state->game.lucia_position.z + ray.z * hit->distance, 0.0f, state->game.percieved_wall_height))
+			{
+				RGBA scan_pixel = sample_rgba_at(&hit->sprite->image, { hit->portion, (static_cast<f32>(y) - hit->starting_y) / (hit->ending_y - hit->starting_y) });
+				if (scan_pixel.a)
+				{
+#if DEBUG_DISABLE_SAMPLING
+					*current_pixel = pack_color(vx3(clamp(2.0f / (hit->distance + 0.1f) * square(dot(hit->sprite->normal, ray.xy)), 0.0f, 1.0f)));
+#else
+					*current_pixel = pack_color(shader(state, rgba_to_color(scan_pixel), hit->sprite->material, hit->in_light, ray, vxx(hit->sprite->normal, 0.0f), hit->distance));
+#endif
+					goto NEXT_Y;
+				}
+			}
+		}
+
+		if (IN_RANGE(y, wall_starting_y, wall_ending_y))
+		{
+			f32 y_portion = (y - wall_starting_y) * wall_inv_height;
+			f32 distance  = sqrtf(square(wall_distance) + square(y_portion * state->game.percieved_wall_height - state->game.lucia_position.z));
+
+#if DEBUG_DISABLE_SAMPLING
+			*current_pixel = pack_color(vx3(clamp(4.0f / (distance + 0.1f) + square(dot(ray_casted_wall_side.normal, ray.xy)), 0.0f, 1.0f)));
+#else
+			RGBA wall_overlay_color = {};
+			if (wall_overlay && IN_RANGE(y_portion, wall_overlay_uv_position.y, wall_overlay_uv_position.y + wall_overlay_uv_dimensions.y))
+			{
+				wall_overlay_color = sample_rgba_at(wall_overlay, { (wall_portion - wall_overlay_uv_position.x) / wall_overlay_uv_dimensions.x, (y_portion - wall_overlay_uv_position.y) / wall_overlay_uv_dimensions.y });
+			}
+
+			RGBA wall_color = wall_overlay_color;
+			if (wall_overlay_color.a < 255 && wall_stepped)
+			{
+				lambda get_wall_texel =
+					[&](i32 i)
+					{
+						return wall_texel_columns[i][clamp((wall_texel_starts[i] - (y - wall_first_y) * wall_texel_steps[i]) >> 16, 0, wall_texel_heights[i] - 1)];
+					};
+
+				wall_color = get_wall_texel(0);
+				if (wall_level_t)
+				{
+					wall_color = lerp(wall_color, get_wall_texel(1), wall_level_t);
+				}
+				wall_color = blend_premultiplied(wall_color, wall_overlay_color);
+			}
+			else if (wall_overlay_color.a < 255)
+			{
+				vf2 wall_uv = { wall_portion * (1.0f + state->game.interpolated_pills_effect_activations[1]) + state->game.interpolated_pills_effect_activations[0] / 2.0f, y_portion * (1.0f + state->game.interpolated_pills_effect_activations[2]) + wall_uv_shift };
+				wall_uv = { wall_uv.x * wall_uv_rotation.x - wall_uv.y * wall_uv_rotation.y, wall_uv.x * wall_uv_rotation.y + wall_uv.y * wall_uv_rotation.x };
+				wall_color =
+					blend_premultiplied
+					(
+						sample_rgba_at
+						(
+							&state->game.mipmap.wall,
+							get_wall_level(distance, ray),
+							{ mod(wall_uv.x, 1.0f), mod(wall_uv.y, 1.0f) }
+						),
+						wall_overlay_color
+					);
+			}
+
+			*current_pixel =
+				pack_color
+				(
+					shader
+					(
+						state,
+						rgba_to_color(wall_color),
+						Material::wall,
+						wall_in_light,
+						ray,
+						vxx(ray_casted_wall_side.normal, 0.0f),
+						distance
+					)
+				);
+#endif
+		}
+
+		NEXT_Y:;
+		current_pixel += 1;
+	}
+
+	stage_counters[+RenderStage::shading] += SDL_GetPerformanceCounter() - stage_counter;
+}
+
+// @NOTE@ Every floor or ceiling pixel of a row is the same distance away, so the mipmap level and most of the lighting is done once per row and the rest four columns at a time.
+internal void render_floor_ceiling_span(u32* view_pixels, State* state, ViewColumn* columns, i32 start_x, i32 end_x)
+{
+	ASSERT(IN_RANGE(end_x - start_x, 1, 5));
+
+	f32 ray_xs          [4];
+	f32 ray_ys          [4];
+	i32 wall_starting_ys[4];
+	i32 wall_ending_ys  [4];
+	FOR_RANGE(i, 4)
+	{
+		if (i < end_x - start_x)
+		{
+			ray_xs          [i] = columns[i].ray_horizontal.x;
+			ray_ys          [i] = columns[i].ray_horizontal.y;
+			wall_starting_ys[i] = columns[i].wall_starting_y;
+			wall_ending_ys  [i] = columns[i].wall_ending_y;
+		}
+		else
+		{
+			ray_xs          [i] = 0.0f;
+			ray_ys          [i] = 0.0f;
+			wall_starting_ys[i] = 0;
+			wall_ending_ys  [i] = VIEW_RES.y;
+		}
+	}
+
+	__m128  m_ray_x            = _mm_loadu_ps(ray_xs);
+	__m128  m_ray_y            = _mm_loadu_ps(ray_ys);
+	__m128i mi_wall_starting_y = _mm_loadu_si128(reinterpret_cast<__m128i*>(wall_starting_ys));
+	__m128i mi_wall_ending_y   = _mm_loadu_si128(reinterpret_cast<__m128i*>(wall_ending_ys));
+	__m128  m_map_dim          = _mm_set_ps1(MAP_DIM * WALL_SPACING);
+	__m128i mi_byte_mask       = _mm_set1_epi32(0xFF);
+
+	vf2 lucia_to_monster = ray_to_closest(state->game.lucia_position.xy, state->game.monster_position.xy);
+	vf2 floor_sway       = fast_polar(state->time / 5.0f);
+	vf2 ceiling_sway     = fast_polar(state->time / 8.0f);
+
+	lambda wrap = // @NOTE@ Same as `ray_to_closest` but for displacements.
+		[&](vf2x4 displacement)
+		{
+			return vf2x4 { displacement.x - round(displacement.x / f32x4 { m_map_dim }) * f32x4 { m_map_dim }, displacement.y - round(displacement.y / f32x4 { m_map_dim }) * f32x4 { m_map_dim } };
+		};
+
+	lambda fract =
+		[&](__m128 m_x)
+		{
+			__m128 m_truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(m_x));
+			return _mm_sub_ps(m_x, _mm_sub_ps(m_truncated, _mm_and_ps(_mm_cmpgt_ps(m_truncated, m_x), m_1)));
+		};
+
+	FOR_RANGE(y, VIEW_RES.y)
+	{
+		f32 ray_xy = state->game.render_row_ray_xys[y];
+		f32 ray_z  = state->game.render_row_ray_zs [y];
+
+		if (fabsf(ray_z) <= 0.0001f)
+		{
+			continue;
+		}
+
+		__m128i mi_y   = _mm_set1_epi32(y);
+		i32     mask   = _mm_movemask_ps(_mm_castsi128_ps(_mm_or_si128(_mm_cmplt_epi32(mi_y, mi_wall_starting_y), _mm_cmpgt_epi32(_mm_add_epi32(mi_y, _mm_set1_epi32(1)), mi_wall_ending_y))));
+		__m128  m_r;
+		__m128  m_g;
+		__m128  m_b;
+
+		if (!mask)
+		{
+			continue;
+		}
+
+#if DEBUG_DISABLE_FLOOR_CEILING
+		m_r = m_0;
+		m_g = m_0;
+		m_b = m_0;
+#else
+		f32      plane_z;
+		f32      normal_z;
+		Mipmap*  mipmap;
+		Material material;
+		f32      uv_dim;
+		vf2      uv_offset;
+
+		if (y < VIEW_RES.y / 2)
+		{
+			plane_z  = 0.0f;
+			normal_z = 1.0f;
+			mipmap   = &state->game.mipmap.floor;
+			material = Material::floor;
+		}
+		else
+		{
+			plane_z  = state->game.percieved_wall_height;
+			normal_z = -1.0f;
+			mipmap   = &state->game.mipmap.ceiling;
+			material = Material::ceiling;
+		}
+
+		f32 distance = (plane_z - state->game.lucia_position.z) / ray_z;
+		f32 reach    = distance * ray_xy; // @NOTE@ How far the pixels are from Lucia along the ground.
+
+		if (material == Material::floor)
+		{
+			uv_dim    = MAP_DIM * WALL_SPACING / roundf(MAP_DIM * WALL_SPACING / 4.0f);
+			uv_offset =
+				{
+					floor_sway.x * state->game.interpolated_pills_effect_activations[2] * 8.0f / (distance + 4.0f),
+					floor_sway.y * state->game.interpolated_pills_effect_activations[3] * 8.0f / (distance + 4.0f)
+				};
+		}
+		else
+		{
+			uv_dim    = MAP_DIM * WALL_SPACING / roundf(MAP_DIM * WALL_SPACING / 4.0f) + state->game.interpolated_pills_effect_activations[3];
+			uv_offset =
+				{
+					ceiling_sway.x * state->game.interpolated_pills_effect_activations[3] * 16.0f / (distance + 3.0f),
+					ceiling_sway.y * state->game.interpolated_pills_effect_activations[2] * 16.0f / (distance + 3.0f)
+				};
+		}
+
+		vf2x4 reaches = vf2x4 { { m_ray_x }, { m_ray_y } } * reach;
+
+#if DEBUG_DISABLE_SAMPLING
+		m_r = _mm_set_ps1(clamp(2.0f / (distance + 0.1f) + square(ray_z), 0.0f, 1.0f));
+		m_g = m_r;
+		m_b = m_r;
+#else
+		__m128 m_u = fract(_mm_add_ps(_mm_div_ps(_mm_add_ps(_mm_set_ps1(state->game.lucia_position.x), reaches.x.m), _mm_set_ps1(uv_dim)), _mm_set_ps1(uv_offset.x)));
+		__m128 m_v = fract(_mm_add_ps(_mm_div_ps(_mm_add_ps(_mm_set_ps1(state->game.lucia_position.y), reaches.y.m), _mm_set_ps1(uv_dim)), _mm_set_ps1(uv_offset.y)));
+
+		f32 level = (distance / 16.0f + mipmap->level_count * square(1.0f - fabsf(ray_z))) * (1.0f - state->game.interpolated_eye_drops_activation);
+#if DEBUG_DISABLE_MIPMAPPING
+		level = 0.0f;
+#endif
+		i32 level_index = static_cast<i32>(clamp(level, 0.0f, mipmap->level_count - 1.0f));
+
+		lambda sample_level =
+			[&](i32 l)
+			{
+				i32    offset = mipmap->base_dim.x * mipmap->base_dim.y * 4 / 3 - mipmap->base_dim.x * mipmap->base_dim.y * 4 / 3 / (1 << (l * 2));
+				vi2    dim    = mipmap->base_dim / (1 << l);
+				__m128 m_i    = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_mul_ps(m_u, _mm_set_ps1(dim.x - 1.0f))));
+				__m128 m_j    = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_mul_ps(_mm_sub_ps(m_1, m_v), _mm_set_ps1(dim.y - 1.0f))));
+
+				i32 indices[4];
+				u32 texels [4];
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(indices), _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(m_i, _mm_set_ps1(static_cast<f32>(dim.y))), m_j)));
+				FOR_RANGE(i, 4)
+				{
+					texels[i] = mipmap->data[offset + indices[i]].rgba;
+				}
+
+				return _mm_loadu_si128(reinterpret_cast<__m128i*>(texels));
+			};
+
+		__m128i mi_texels = sample_level(level_index);
+
+		if (IN_RANGE(level, 0.0f, mipmap->level_count - 1.0f)) // @NOTE@ Blends the two levels as bytes widened to 16-bit lanes in 1/256ths, the same as `lerp(RGBA, RGBA, u32)`.
+		{
+			__m128i mi_next_texels = sample_level(level_index + 1);
+			__m128i mi_t           = _mm_set1_epi16(static_cast<i16>((level - level_index) * 256.0f));
+			__m128i mi_inv_t       = _mm_sub_epi16(_mm_set1_epi16(256), mi_t);
+
+			lambda blend =
+				[&](__m128i mi_p, __m128i mi_q)
+				{
+					return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(mi_p, mi_inv_t), _mm_mullo_epi16(mi_q, mi_t)), 8);
+				};
+
+			mi_texels =
+				_mm_packus_epi16
+				(
+					blend(_mm_unpacklo_epi8(mi_texels, _mm_setzero_si128()), _mm_unpacklo_epi8(mi_next_texels, _mm_setzero_si128())),
+					blend(_mm_unpackhi_epi8(mi_texels, _mm_setzero_si128()), _mm_unpackhi_epi8(mi_next_texels, _mm_setzero_si128()))
+				);
+		}
+
+		m_r = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(                 mi_texels     , mi_byte_mask)), _mm_set_ps1(1.0f / 255.0f));
+		m_g = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(mi_texels,  8), mi_byte_mask)), _mm_set_ps1(1.0f / 255.0f));
+		m_b = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(mi_texels, 16), mi_byte_mask)), _mm_set_ps1(1.0f / 255.0f));
+
+#if !DEBUG_DISABLE_SHADER // @NOTE@ What `shader` does for the floor and ceiling, whose normal is straight up or down.
+		f32   ambient_light    = get_ambient_light(state, material, state->game.lucia_position.z + ray_z * distance, distance);
+		f32x4 flashlight_dot   = (f32x4 { m_ray_x } * state->game.flashlight_ray.x + f32x4 { m_ray_y } * state->game.flashlight_ray.y) * ray_xy + ray_z * state->game.flashlight_ray.z;
+		f32x4 flashlight_light = get_flashlight_light(state, flashlight_dot, ray_z * normal_z, distance);
+
+		f32x4 fire_light = { m_0 };
+		if (state->game.monster_timeout == 0.0f)
+		{
+			constexpr f32 SHADER_INV_EPSILON = 0.9f;
+
+			vf2x4 to_lights = wrap(reaches * SHADER_INV_EPSILON - lucia_to_monster);
+
+			i32 bins[4];
+			f32 depths[4];
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(bins), _mm_cvttps_epi32(_mm_mul_ps(get_diamond_angle(to_lights.x.m, to_lights.y.m), _mm_set_ps1(MONSTER_LIGHT_BIN_COUNT / 4.0f))));
+			FOR_RANGE(i, 4)
+			{
+				depths[i] = state->game.monster_light_depths[clamp(bins[i], 0, MONSTER_LIGHT_BIN_COUNT - 1)];
+			}
+
+			mask32x4 in_lights  = norm_sq(to_lights) < square(f32x4 { _mm_loadu_ps(depths) });
+			vf2x4    frag_rays  = wrap(lucia_to_monster - reaches);
+			f32      frag_ray_z = state->game.monster_position.z - (state->game.lucia_position.z + ray_z * distance);
+
+			fire_light = select(in_lights, get_fire_light(norm_sq(frag_rays) + square(frag_ray_z), frag_ray_z * normal_z), { m_0 });
+		}
+
+		vf3x4 color = apply_light(state, vf3x4 { { m_r }, { m_g }, { m_b } }, ambient_light, flashlight_light, fire_light);
+		m_r = color.x.m;
+		m_g = color.y.m;
+		m_b = color.z.m;
+#endif
+#endif
+#endif
+
+		store_view_pixels(view_pixels + start_x * VIEW_RES.y + y, mask, m_r, m_g, m_b);
+	}
+}
+
+internal void render_vertical_scan_lines(u32* view_pixels, State* state, i32 start_x, i32 end_x, u64* stage_counters)
+{
+	for (i32 x = start_x; x < end_x; x += 4)
+	{
+		i32         span_end_x = min(x + 4, end_x);
+		ViewColumn* columns    = &state->game.render_view_columns[x];
+
+		u64 stage_counter = SDL_GetPerformanceCounter();
+		render_floor_ceiling_span(view_pixels, state, columns, x, span_end_x);
+		stage_counters[+RenderStage::shading] += SDL_GetPerformanceCounter() - stage_counter;
+
+		FOR_RANGE(i, span_end_x - x)
+		{
+			render_vertical_scan_line(view_pixels + (x + i) * VIEW_RES.y, state, &columns[i], x + i, stage_counters);
+		}
+	}
+}
+
+// @NOTE@ The frame-wide inputs of `post_process_pixels`.
+struct PostProcessEffects
+{
+	f32 blur;
+	f32 night_vision_goggles_activation;
+	f32 night_vision_goggles_scan_line_keytime;
+	f32 flash;
+	f32 high;
+	f32 blink_activation;
+};
+
+internal PostProcessEffects get_post_process_effects(State* state)
+{
+	f32 interpolated_pill_dosage_total = 0.0f;
+	FOR_ELEMS(it, state->game.interpolated_pills_effect_activations)
+	{
+		interpolated_pill_dosage_total += *it;
+	}
+
+	PostProcessEffects effects = {};
+	effects.blur                                   = state->game.render_thread_blur;
+	effects.night_vision_goggles_activation        = state->game.night_vision_goggles_activation;
+	effects.night_vision_goggles_scan_line_keytime = state->game.night_vision_goggles_scan_line_keytime;
+	effects.flash                                  = 1.0f + 128.0f * square(state->game.flash_stun_activation);
+	effects.high                                   = 1.0f + square(min(interpolated_pill_dosage_total, 0.15f));
+	effects.blink_activation                       = state->game.lucia_blink_activation;
+	return effects;
+}
+
+// @NOTE@ The night vision goggles' scan line and the blink's darkening of row `y` of `view_pixels`.
+internal FORCE_INLINE void get_post_process_row_effects(PostProcessEffects effects, i32 y, f32* scan_line, f32* blink)
+{
+	*scan_line = fabsf(0.5f - y % 3 / 3.0f);
+	*blink     = clamp(square(1.0f - effects.blink_activation) - fabsf(1.0f - 2.0f * static_cast<f32>(y) / VIEW_RES.y) * effects.blink_activation, 0.0f, 1.0f);
+}
+
+// @NOTE@ The per-pixel math of the post-processor, shared by the SSE, AVX2, and AVX-512 kernels so they only have to load, transpose, and store.
+// `color` comes in as the shading and leaves blurred against `old_color` with the effects applied, in [0, 1]. `x` is the column of each lane.
+template <typename VF3XN, typename F32XN>
+internal FORCE_INLINE void post_process_pixels(VF3XN* color, const VF3XN& old_color, const F32XN& x, const F32XN& scan_line, const F32XN& blink, PostProcessEffects effects)
+{
+	#if !DEBUG_DISABLE_POSTPROCESSOR
+	F32XN r = lerp(old_color.x, color->x, effects.blur);
+	F32XN g = lerp(old_color.y, color->y, effects.blur);
+	F32XN b = lerp(old_color.z, color->z, effects.blur);
+
+	F32XN scan_line_delta = clamp(square((x / static_cast<f32>(VIEW_RES.x) - effects.night_vision_goggles_scan_line_keytime) * 8.0f), 0.0f, 1.0f);
+	F32XN avg_rgb         = (r + g + b) / 3.0f;
+	F32XN t               = 1.2f + (1.0f - scan_line_delta) * scan_line * effects.night_vision_goggles_activation;
+
+	r = lerp(r, avg_rgb * (0.0f * t), effects.night_vision_goggles_activation) * effects.flash;
+	g = lerp(g, avg_rgb * (2.4f * t), effects.night_vision_goggles_activation) * effects.flash;
+	b = lerp(b, avg_rgb * (0.0f * t), effects.night_vision_goggles_activation) * effects.flash;
+
+	r = r * effects.high;
+
+	color->x = clamp(r, 0.0f, 1.0f) * blink;
+	color->y = clamp(g, 0.0f, 1.0f) * blink;
+	color->z = clamp(b, 0.0f, 1.0f) * blink;
+	#endif
+}
+
+// @NOTE@ Between the RGBA8888 of `view_pixels` and colors in [0, 1].
+internal vf3x4 unpack_view_colors(__m128i mi_rgba)
+{
+	__m128i mi_byte_mask = _mm_set1_epi32(0xFF);
+	return
+		{
+			{ _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(mi_rgba, 24), mi_byte_mask)), m_255) },
+			{ _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(mi_rgba, 16), mi_byte_mask)), m_255) },
+			{ _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(mi_rgba,  8), mi_byte_mask)), m_255) }
+		};
+}
+
+internal __m128i pack_view_colors(vf3x4 color)
+{
+	return
+		_mm_or_si128
+		(
+			_mm_or_si128
+			(
+				_mm_slli_epi32(_mm_cvtps_epi32(_mm_mul_ps(color.x.m, m_255)), 24),
+				_mm_slli_epi32(_mm_cvtps_epi32(_mm_mul_ps(color.y.m, m_255)), 16)
+			),
+			_mm_slli_epi32(_mm_cvtps_epi32(_mm_mul_ps(color.z.m, m_255)), 8)
+		);
+}
+
+internal TARGET_AVX2 vf3x8 unpack_view_colors(__m256i mi8_rgba)
+{
+	__m256  m8_255        = _mm256_set1_ps(255.0f);
+	__m256i mi8_byte_mask = _mm256_set1_epi32(0xFF);
+	return
+		{
+			{ _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(mi8_rgba, 24), mi8_byte_mask)), m8_255) },
+			{ _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(mi8_rgba, 16), mi8_byte_mask)), m8_255) },
+			{ _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(mi8_rgba,  8), mi8_byte_mask)), m8_255) }
+		};
+}
+
+internal TARGET_AVX2 __m256i pack_view_colors(vf3x8 color)
+{
+	__m256 m8_255 = _mm256_set1_ps(255.0f);
+	return
+		_mm256_or_si256
+		(
+			_mm256_or_si256
+			(
+				_mm256_slli_epi32(_mm256_cvtps_epi32(_mm256_mul_ps(color.x.m, m8_255)), 24),
+				_mm256_slli_epi32(_mm256_cvtps_epi32(_mm256_mul_ps(color.y.m, m8_255)), 16)
+			),
+			_mm256_slli_epi32(_mm256_cvtps_epi32(_mm256_mul_ps(color.z.m, m8_255)), 8)
+		);
+}
+
+internal TARGET_AVX512 vf3x16 unpack_view_colors(__m512i mi16_rgba)
+{
+	__m512  m16_255        = _mm512_set1_ps(255.0f);
+	__m512i mi16_byte_mask = _mm512_set1_epi32(0xFF);
+	return
+		{
+			{ _mm512_div_ps(_mm512_cvtepi32_ps(_mm512_and_si512(_mm512_srli_epi32(mi16_rgba, 24), mi16_byte_mask)), m16_255) },
+			{ _mm512_div_ps(_mm512_cvtepi32_ps(_mm512_and_si512(_mm512_srli_epi32(mi16_rgba, 16), mi16_byte_mask)), m16_255) },
+			{ _mm512_div_ps(_mm512_cvtepi32_ps(_mm512_and_si512(_mm512_srli_epi32(mi16_rgba,  8), mi16_byte_mask)), m16_255) }
+		};
+}
+
+internal TARGET_AVX512 __m512i pack_view_colors(vf3x16 color)
+{
+	__m512 m16_255 = _mm512_set1_ps(255.0f);
+	return
+		_mm512_or_si512
+		(
+			_mm512_or_si512
+			(
+				_mm512_slli_epi32(_mm512_cvtps_epi32(_mm512_mul_ps(color.x.m, m16_255)), 24),
+				_mm512_slli_epi32(_mm512_cvtps_epi32(_mm512_mul_ps(color.y.m, m16_255)), 16)
+			),
+			_mm512_slli_epi32(_mm512_cvtps_epi32(_mm512_mul_ps(color.z.m, m16_255)), 8)
+		);
+}
+
+// @NOTE@ Transposes the columns from `render_vertical_scan_lines` 4x4 blocks at a time and post-processes the rows of the block straight into `view_pixels`, which is row-major and top-down.
+// `view_pixels` has to keep the previous frame since the blur blends against it. Blocks on the right edge read from the padding of the columns.
+internal void post_process_view_pixels(State* state, u32* view_pixels, i32 start_x, i32 end_x)
+{
+	ASSERT(start_x % 4 == 0);
+
+	PostProcessEffects effects = get_post_process_effects(state);
+
+	for (i32 x = start_x; x < end_x; x += 4)
+	{
+		f32x4 lane_xs = { _mm_add_ps(_mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f), _mm_set_ps1(static_cast<f32>(x))) };
+
+		lambda post_process =
+			[&](vf3x4 color, i32 y)
+			{
+				f32 scan_line;
+				f32 blink;
+				get_post_process_row_effects(effects, y, &scan_line, &blink);
+
+				u32* view_colors = view_pixels + y * VIEW_RES.x + x;
+				u32  edge_view_colors[4];
+				if (x + 4 > VIEW_RES.x)
+				{
+					FOR_RANGE(i, VIEW_RES.x - x)
+					{
+						edge_view_colors[i] = view_colors[i];
+					}
+					view_colors = edge_view_colors;
+				}
+
+				post_process_pixels(&color, unpack_view_colors(_mm_loadu_si128(reinterpret_cast<__m128i*>(view_colors))), lane_xs, splat4(scan_line), splat4(blink), effects);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(view_colors), pack_view_colors(color));
+				if (view_colors == edge_view_colors)
+				{
+					FOR_RANGE(i, VIEW_RES.x - x)
+					{
+						view_pixels[y * VIEW_RES.x + x + i] = edge_view_colors[i];
+					}
+				}
+			};
+
+		u32* column_pixels = state->game.render_thread_view_pixels;
+
+		i32 y = 0;
+		for (; y + 4 <= VIEW_RES.y; y += 4)
+		{
+			__m128i mi_column_0 = _mm_loadu_si128(reinterpret_cast<__m128i*>(column_pixels + (x + 0) * VIEW_RES.y + y));
+			__m128i mi_column_1 = _mm_loadu_si128(reinterpret_cast<__m128i*>(column_pixels + (x + 1) * VIEW_RES.y + y));
+			__m128i mi_column_2 = _mm_loadu_si128(reinterpret_cast<__m128i*>(column_pixels + (x + 2) * VIEW_RES.y + y));
+			__m128i mi_column_3 = _mm_loadu_si128(reinterpret_cast<__m128i*>(column_pixels + (x + 3) * VIEW_RES.y + y));
+
+			__m128i mi_low_01  = _mm_unpacklo_epi32(mi_column_0, mi_column_1);
+			__m128i mi_low_23  = _mm_unpacklo_epi32(mi_column_2, mi_column_3);
+			__m128i mi_high_01 = _mm_unpackhi_epi32(mi_column_0, mi_column_1);
+			__m128i mi_high_23 = _mm_unpackhi_epi32(mi_column_2, mi_column_3);
+
+			post_process(unpack_view_colors(_mm_unpacklo_epi64(mi_low_01 , mi_low_23 )), VIEW_RES.y - 1 - (y + 0));
+			post_process(unpack_view_colors(_mm_unpackhi_epi64(mi_low_01 , mi_low_23 )), VIEW_RES.y - 1 - (y + 1));
+			post_process(unpack_view_colors(_mm_unpacklo_epi64(mi_high_01, mi_high_23)), VIEW_RES.y - 1 - (y + 2));
+			post_process(unpack_view_colors(_mm_unpackhi_epi64(mi_high_01, mi_high_23)), VIEW_RES.y - 1 - (y + 3));
+		}
+
+		for (; y < VIEW_RES.y; y += 1)
+		{
+			post_process
+			(
+				unpack_view_colors
+				(
+					_mm_set_epi32
+					(
+						column_pixels[(x + 3) * VIEW_RES.y + y],
+						column_pixels[(x + 2) * VIEW_RES.y + y],
+						column_pixels[(x + 1) * VIEW_RES.y + y],
+						column_pixels[(x + 0) * VIEW_RES.y + y]
+					)
+				),
+				VIEW_RES.y - 1 - y
+			);
+		}
+	}
+}
+
+// @NOTE@ `post_process_view_pixels` eight pixels at a time. The columns are transposed 4x8 blocks at a time so each register holds two rows of four pixels,
+// with its low half being row `y + i` of the columns and its high half being row `y + 4 + i`. Columns on the right edge are left to `post_process_view_pixels`.
+internal TARGET_AVX2 void post_process_view_pixels_avx2(State* state, u32* view_pixels, i32 start_x, i32 end_x)
+{
+	ASSERT(start_x % 4 == 0);
+
+	PostProcessEffects effects = get_post_process_effects(state);
+
+	u32* column_pixels = state->game.render_thread_view_pixels;
+
+	i32 x = start_x;
+	for (; x + 4 <= min(end_x, VIEW_RES.x); x += 4)
+	{
+		f32x8 lane_xs = { _mm256_add_ps(_mm256_set_ps(3.0f, 2.0f, 1.0f, 0.0f, 3.0f, 2.0f, 1.0f, 0.0f), _mm256_set1_ps(static_cast<f32>(x))) };
+
+		for (i32 y = 0; y < VIEW_RES.y; y += 8)
+		{
+			__m256i mi8_rows[4];
+			if (y + 8 <= VIEW_RES.y)
+			{
+				__m256i mi8_column_0 = _mm256_loadu_si256(reinterpret_cast<__m256i*>(column_pixels + (x + 0) * VIEW_RES.y + y));
+				__m256i mi8_column_1 = _mm256_loadu_si256(reinterpret_cast<__m256i*>(column_pixels + (x + 1) * VIEW_RES.y + y));
+				__m256i mi8_column_2 = _mm256_loadu_si256(reinterpret_cast<__m256i*>(column_pixels + (x + 2) * VIEW_RES.y + y));
+				__m256i mi8_column_3 = _mm256_loadu_si256(reinterpret_cast<__m256i*>(column_pixels + (x + 3) * VIEW_RES.y + y));
+
+				__m256i mi8_low_01  = _mm256_unpacklo_epi32(mi8_column_0, mi8_column_1);
+				__m256i mi8_low_23  = _mm256_unpacklo_epi32(mi8_column_2, mi8_column_3);
+				__m256i mi8_high_01 = _mm256_unpackhi_epi32(mi8_column_0, mi8_column_1);
+				__m256i mi8_high_23 = _mm256_unpackhi_epi32(mi8_column_2, mi8_column_3);
+
+				mi8_rows[0] = _mm256_unpacklo_epi64(mi8_low_01 , mi8_low_23 );
+				mi8_rows[1] = _mm256_unpackhi_epi64(mi8_low_01 , mi8_low_23 );
+				mi8_rows[2] = _mm256_unpacklo_epi64(mi8_high_01, mi8_high_23);
+				mi8_rows[3] = _mm256_unpackhi_epi64(mi8_high_01, mi8_high_23);
+			}
+			else
+			{
+				u32 tail_rows[4][8] = {};
+				FOR_RANGE(i, VIEW_RES.y - y)
+				{
+					FOR_RANGE(j, 4)
+					{
+						tail_rows[i % 4][i / 4 * 4 + j] = column_pixels[(x + j) * VIEW_RES.y + y + i];
+					}
+				}
+
+				FOR_ELEMS(it, mi8_rows)
+				{
+					*it = _mm256_loadu_si256(reinterpret_cast<__m256i*>(tail_rows[it_index]));
+				}
+			}
+
+			FOR_RANGE(i, min(4, VIEW_RES.y - y))
+			{
+				bool32 high_exists = y + 4 + i < VIEW_RES.y; // @NOTE@ Otherwise the high half repeats the low half's row and is never stored.
+				u32*   low_colors  = view_pixels + (VIEW_RES.y - 1 - (y + i)) * VIEW_RES.x + x;
+				u32*   high_colors = high_exists ? view_pixels + (VIEW_RES.y - 1 - (y + 4 + i)) * VIEW_RES.x + x : low_colors;
+
+				f32 scan_lines[8];
+				f32 blinks    [8];
+				FOR_RANGE(j, 8)
+				{
+					get_post_process_row_effects(effects, VIEW_RES.y - 1 - (j < 4 || !high_exists ? y + i : y + 4 + i), &scan_lines[j], &blinks[j]);
+				}
+
+				vf3x8 color = unpack_view_colors(mi8_rows[i]);
+
+				__m256i mi8_old_rgba = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i*>(low_colors))), _mm_loadu_si128(reinterpret_cast<__m128i*>(high_colors)), 1);
+				post_process_pixels(&color, unpack_view_colors(mi8_old_rgba), lane_xs, f32x8 { _mm256_loadu_ps(scan_lines) }, f32x8 { _mm256_loadu_ps(blinks) }, effects);
+
+				__m256i mi8_rgba = pack_view_colors(color);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(low_colors), _mm256_castsi256_si128(mi8_rgba));
+				if (high_exists)
+				{
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(high_colors), _mm256_extracti128_si256(mi8_rgba, 1));
+				}
+			}
+		}
+	}
+
+	if (x < end_x)
+	{
+		post_process_view_pixels(state, view_pixels, x, end_x);
+	}
+}
+
+// @NOTE@ `post_process_view_pixels` sixteen pixels at a time. The columns are transposed 4x16 blocks at a time so each register holds four rows of four pixels,
+// with its `j`th quarter being row `y + 4 * j + i` of the columns. Columns on the right edge are left to `post_process_view_pixels`.
+internal TARGET_AVX512 void post_process_view_pixels_avx512(State* state, u32* view_pixels, i32 start_x, i32 end_x)
+{
+	ASSERT(start_x % 4 == 0);
+
+	PostProcessEffects effects = get_post_process_effects(state);
+
+	u32* column_pixels = state->game.render_thread_view_pixels;
+
+	i32 x = start_x;
+	for (; x + 4 <= min(end_x, VIEW_RES.x); x += 4)
+	{
+		f32x16 lane_xs = { _mm512_add_ps(_mm512_set_ps(3.0f, 2.0f, 1.0f, 0.0f, 3.0f, 2.0f, 1.0f, 0.0f, 3.0f, 2.0f, 1.0f, 0.0f, 3.0f, 2.0f, 1.0f, 0.0f), _mm512_set1_ps(static_cast<f32>(x))) };
+
+		for (i32 y = 0; y < VIEW_RES.y; y += 16)
+		{
+			__m512i mi16_rows[4];
+			if (y + 16 <= VIEW_RES.y)
+			{
+				__m512i mi16_column_0 = _mm512_loadu_si512(column_pixels + (x + 0) * VIEW_RES.y + y);
+				__m512i mi16_column_1 = _mm512_loadu_si512(column_pixels + (x + 1) * VIEW_RES.y + y);
+				__m512i mi16_column_2 = _mm512_loadu_si512(column_pixels + (x + 2) * VIEW_RES.y + y);
+				__m512i mi16_column_3 = _mm512_loadu_si512(column_pixels + (x + 3) * VIEW_RES.y + y);
+
+				__m512i mi16_low_01  = _mm512_unpacklo_epi32(mi16_column_0, mi16_column_1);
+				__m512i mi16_low_23  = _mm512_unpacklo_epi32(mi16_column_2, mi16_column_3);
+				__m512i mi16_high_01 = _mm512_unpackhi_epi32(mi16_column_0, mi16_column_1);
+				__m512i mi16_high_23 = _mm512_unpackhi_epi32(mi16_column_2, mi16_column_3);
+
+				mi16_rows[0] = _mm512_unpacklo_epi64(mi16_low_01 , mi16_low_23 );
+				mi16_rows[1] = _mm512_unpackhi_epi64(mi16_low_01 , mi16_low_23 );
+				mi16_rows[2] = _mm512_unpacklo_epi64(mi16_high_01, mi16_high_23);
+				mi16_rows[3] = _mm512_unpackhi_epi64(mi16_high_01, mi16_high_23);
+			}
+			else
+			{
+				u32 tail_rows[4][16] = {};
+				FOR_RANGE(i, VIEW_RES.y - y)
+				{
+					FOR_RANGE(j, 4)
+					{
+						tail_rows[i % 4][i / 4 * 4 + j] = column_pixels[(x + j) * VIEW_RES.y + y + i];
+					}
+				}
+
+				FOR_ELEMS(it, mi16_rows)
+				{
+					*it = _mm512_loadu_si512(tail_rows[it_index]);
+				}
+			}
+
+			FOR_RANGE(i, min(4, VIEW_RES.y - y))
+			{
+				i32  row_count = (VIEW_RES.y - y - i + 3) / 4; // @NOTE@ Quarters past the last row repeat the first quarter's row and are never stored.
+				u32* row_colors[4];
+				f32  scan_lines[16];
+				f32  blinks    [16];
+				FOR_RANGE(j, 4)
+				{
+					i32 row_y = VIEW_RES.y - 1 - (j < row_count ? y + 4 * j + i : y + i);
+					row_colors[j] = view_pixels + row_y * VIEW_RES.x + x;
+					FOR_RANGE(k, 4)
+					{
+						get_post_process_row_effects(effects, row_y, &scan_lines[j * 4 + k], &blinks[j * 4 + k]);
+					}
+				}
+
+				vf3x16 color = unpack_view_colors(mi16_rows[i]);
+
+				__m512i mi16_old_rgba = _mm512_castsi128_si512(_mm_loadu_si128(reinterpret_cast<__m128i*>(row_colors[0])));
+				mi16_old_rgba = _mm512_inserti32x4(mi16_old_rgba, _mm_loadu_si128(reinterpret_cast<__m128i*>(row_colors[1])), 1);
+				mi16_old_rgba = _mm512_inserti32x4(mi16_old_rgba, _mm_loadu_si128(reinterpret_cast<__m128i*>(row_colors[2])), 2);
+				mi16_old_rgba = _mm512_inserti32x4(mi16_old_rgba, _mm_loadu_si128(reinterpret_cast<__m128i*>(row_colors[3])), 3);
+				post_process_pixels(&color, unpack_view_colors(mi16_old_rgba), lane_xs, f32x16 { _mm512_loadu_ps(scan_lines) }, f32x16 { _mm512_loadu_ps(blinks) }, effects);
+
+				__m512i mi16_rgba = pack_view_colors(color);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(row_colors[0]), _mm512_castsi512_si128(mi16_rgba));
+				if (row_count > 1) { _mm_storeu_si128(reinterpret_cast<__m128i*>(row_colors[1]), _mm512_extracti32x4_epi32(mi16_rgba, 1)); }
+				if (row_count > 2) { _mm_storeu_si128(reinterpret_cast<__m128i*>(row_colors[2]), _mm512_extracti32x4_epi32(mi16_rgba, 2)); }
+				if (row_count > 3) { _mm_storeu_si128(reinterpret_cast<__m128i*>(row_colors[3]), _mm512_extracti32x4_epi32(mi16_rgba, 3)); }
+			}
+		}
+	}
+
+	if (x < end_x)
+	{
+		post_process_view_pixels(state, view_pixels, x, end_x);
+	}
+}
+
+// @NOTE@ Returns -1 when the range is empty.
+internal i32 take_render_chunk(SDL_atomic_t* chunk_range, bool32 from_back)
+{
+	while (true)
+	{
+		i32 range = SDL_AtomicGet(chunk_range);
+		i32 front = range >> 16;
+		i32 back  = range & 0xFFFF;
+
+		if (front >= back)
+		{
+			return -1;
+		}
+		else if (from_back)
+		{
+			if (SDL_AtomicCAS(chunk_range, range, (front << 16) | (back - 1)))
+			{
+				return back - 1;
+			}
+		}
+		else if (SDL_AtomicCAS(chunk_range, range, ((front + 1) << 16) | back))
+		{
+			return front;
+		}
+	}
+}
+
+internal void render_chunks(RenderThreadData* data)
+{
+	PROFILER_scope("render_chunks");
+
+	lambda render_chunk =
+		[&](i32 chunk_index)
+		{
+			i32 start_x = chunk_index * RENDER_CHUNK_WIDTH;
+			i32 end_x   = min(start_x + RENDER_CHUNK_WIDTH, VIEW_RES.x);
+
+			switch (data->state->game.render_thread_phase)
+			{
+				case RenderPhase::cast:
+				{
+					u64 counter = SDL_GetPerformanceCounter();
+					for (i32 x = start_x; x < end_x; x += 4)
+					{
+						cast_view_columns(&data->state->game.render_view_columns[x], data->state, x, min(4, end_x - x));
+					}
+					data->stage_counters[+RenderStage::raycast] += SDL_GetPerformanceCounter() - counter;
+				} break;
+
+				case RenderPhase::shade:
+				{
+					render_vertical_scan_lines(data->state->game.render_thread_view_pixels, data->state, start_x, end_x, data->stage_counters);
+
+					PROFILER_scope("post_process");
+					u64 counter = SDL_GetPerformanceCounter();
+					switch (data->state->game.render_simd_level)
+					{
+						case SIMDLevel::sse2:
+						{
+							post_process_view_pixels(data->state, data->state->game.render_thread_target_pixels, start_x, end_x);
+						} break;
+
+						case SIMDLevel::avx2:
+						{
+							post_process_view_pixels_avx2(data->state, data->state->game.render_thread_target_pixels, start_x, end_x);
+						} break;
+
+						case SIMDLevel::avx512:
+						{
+							post_process_view_pixels_avx512(data->state, data->state->game.render_thread_target_pixels, start_x, end_x);
+						} break;
+					}
+					data->stage_counters[+RenderStage::post_process] += SDL_GetPerformanceCounter() - counter;
+				} break;
+			}
+		};
+
+	for (i32 chunk_index; (chunk_index = take_render_chunk(&data->chunk_range, false)) != -1;)
+	{
+		render_chunk(chunk_index);
+	}
+
+	// @NOTE@ Ranges are only ever refilled at the start of the frame, so one pass over everyone else is enough.
+	FOR_RANGE(i, 1, data->state->game.render_thread_count)
+	{
+		RenderThreadData* victim = &data->state->game.render_thread_datas[(data->index + i) % data->state->game.render_thread_count];
+		for (i32 chunk_index; (chunk_index = take_render_chunk(&victim->chunk_range, true)) != -1;)
+		{
+			render_chunk(chunk_index);
+		}
+	}
+}
+
+internal int render_thread_work(void* void_data)
+{
+	RenderThreadData* data = reinterpret_cast<RenderThreadData*>(void_data);
+
+	profiler_register_thread("render_thread_work");
+
+	while (true)
 	{
-		scan(Material::monster, get_image_of_frame(&state->game.animated_sprite.monster), state->game.monster_position, state->game.monster_normal, { 1.0f, 1.0f });
+		SDL_SemWait(data->clock_in);
 
-		constexpr i32 FIRE_COUNT = 3;
-		FOR_RANGE(i, FIRE_COUNT)
+		if (data->state->game.render_thread_fired)
 		{
-			vf3 fire_position = state->game.monster_position + vxx(polar(state->time + static_cast<f32>(i) / FIRE_COUNT * TAU), 0.0f);
-			if (exists_clear_way(state, state->game.monster_position.xy, fire_position.xy))
-			{
-				scan(Material::fire, get_image_of_frame(&state->game.animated_sprite.fire), fire_position, normalize(ray_to_closest(state->game.monster_position.xy, state->game.lucia_position.xy)), { 1.0f, 1.0f });
-			}
+			return 0;
+		}
+		else
+		{
+			render_chunks(data);
+			SDL_SemPost(data->state->game.render_thread_clock_out);
 		}
 	}
+}
 
-	if (state->game.hand_on_state != HandOnState::null)
+// @NOTE@ Hands out the view's chunks evenly for `phase` and lets the render threads at them; the main thread takes its share in `join_render_threads`.
+internal void release_render_threads(State* state, RenderPhase phase)
+{
+	state->game.render_thread_phase = phase;
+
+	FOR_ELEMS(it, state->game.render_thread_datas, state->game.render_thread_count)
 	{
-		scan(Material::hand, state->game.texture_sprite.hand.image, state->game.hand_position, normalize(ray_to_closest(state->game.hand_position.xy, state->game.lucia_position.xy)), { 0.1f, 0.1f });
+		i32 front = RENDER_CHUNK_COUNT *  it_index      / state->game.render_thread_count;
+		i32 back  = RENDER_CHUNK_COUNT * (it_index + 1) / state->game.render_thread_count;
+		SDL_AtomicSet(&it->chunk_range, (front << 16) | back);
 	}
 
-	FOR_ELEMS(it, state->game.item_buffer, state->game.item_count)
+	FOR_RANGE(i, 1, state->game.render_thread_count)
 	{
-		scan(Material::item, state->game.texture_sprite.default_items[+it->type - +ItemType::ITEM_START].image, it->position, it->normal, { 0.5f, 0.5f });
+		SDL_SemPost(state->game.render_thread_datas[i].clock_in);
 	}
-#endif
+}
 
-	FOR_RANGE(y, VIEW_RES.y)
-	{
-		vf3 ray        = normalize(vf3 { ray_horizontal.x, ray_horizontal.y, (y - VIEW_RES.y / 2.0f) * state->game.lucia_fov / HORT_TO_VERT_K });
-		vf4 scan_pixel = { NAN, NAN, NAN, NAN };
+internal void join_render_threads(State* state)
+{
+	render_chunks(&state->game.render_thread_datas[0]);
 
-		for (RenderScanNode* node = render_scan_node; node; node = node->next_node)
-		{
-			if (IN_RANGE(y, node->starting_y, node->ending_y) && IN_RANGE(state->game.lucia_position.z + ray.z * node->distance, 0.0f, state->game.percieved_wall_height))
-			{
-				scan_pixel = sample_at(&node->image, { node->portion, (static_cast<f32>(y) - node->starting_y) / (node->ending_y - node->starting_y) });
-				if (scan_pixel.w)
-				{
-#if DEBUG_DISABLE_SAMPLING
-					*current_pixel = pack_color(vx3(clamp(2.0f / (node->distance + 0.1f) * square(dot(node->normal, ray.xy)), 0.0f, 1.0f)));
-#else
-					*current_pixel = pack_color(shader(state, scan_pixel.xyz, node->material, node->in_light, ray, vxx(node->normal, 0.0f), node->distance));
-#endif
-					goto NEXT_Y;
-				}
-			}
-		}
+	FOR_RANGE(state->game.render_thread_count - 1)
+	{
+		SDL_SemWait(state->game.render_thread_clock_out);
+	}
+}
 
-		if (IN_RANGE(y, wall_starting_y, wall_ending_y))
-		{
-			f32 y_portion = static_cast<f32>(y - wall_starting_y) / (wall_ending_y - wall_starting_y);
-			f32 distance  = sqrtf(square(wall_distance) + square(y_portion * state->game.percieved_wall_height - state->game.lucia_position.z));
+// @NOTE@ `view_pixels` is row-major and top-down; it has to keep the previous frame since the blur blends against it.
+internal void render_view(State* state, f32 seconds_per_update, u32* view_pixels)
+{
+	PROFILER_scope("render_view");
 
-#if DEBUG_DISABLE_SAMPLING
-			*current_pixel = pack_color(vx3(clamp(4.0f / (distance + 0.1f) + square(dot(ray_casted_wall_side.normal, ray.xy)), 0.0f, 1.0f)));
-#else
-			vf4 wall_overlay_color = { NAN, NAN, NAN, 0.0f };
-			if (wall_overlay && IN_RANGE(y_portion, wall_overlay_uv_position.y, wall_overlay_uv_position.y + wall_overlay_uv_dimensions.y))
-			{
-				wall_overlay_color = sample_at(wall_overlay, { (wall_portion - wall_overlay_uv_position.x) / wall_overlay_uv_dimensions.x, (y_portion - wall_overlay_uv_position.y) / wall_overlay_uv_dimensions.y });
-			}
+	compute_view_rays(state);
 
-			vf3 wall_color = { NAN, NAN, NAN };
-			if (wall_overlay_color.w < 1.0f)
-			{
-				vf2 wall_uv = { wall_portion * (1.0f + state->game.interpolated_pills_effect_activations[1]) + state->game.interpolated_pills_effect_activations[0] / 2.0f, y_portion * (1.0f + state->game.interpolated_pills_effect_activations[2]) + sinf(state->game.interpolated_pills_effect_activations[0]) };
-				wall_uv = rotate(wall_uv, square(state->game.interpolated_pills_effect_activations[0] * 8.0f) / 4.0f);
-				wall_color =
-					sample_at
-					(
-						&state->game.mipmap.wall,
-						(distance / 4.0f + state->game.mipmap.wall.level_count * square(1.0f - fabsf(dot(ray, vxx(ray_casted_wall_side.normal, 0.0f))))) * (1.0f - state->game.interpolated_eye_drops_activation),
-						{ mod(wall_uv.x, 1.0f), mod(wall_uv.y, 1.0f) }
-					);
-			}
+	state->game.render_thread_target_pixels = view_pixels;
+	state->game.render_thread_blur          = state->game.interpolated_blur > 0.001f ? 1.0f - expf(-seconds_per_update / state->game.interpolated_blur) : 1.0f;
 
-			*current_pixel =
-				pack_color
-				(
-					shader
-					(
-						state,
-						wall_overlay_color.w == 0.0f
-							? wall_color
-							: wall_overlay_color.w == 1.0f
-								? wall_overlay_color.xyz
-								: lerp(wall_color, wall_overlay_color.xyz, wall_overlay_color.w),
-						Material::wall,
-						wall_in_light,
-						ray,
-						vxx(ray_casted_wall_side.normal, 0.0f),
-						distance
-					)
-				);
-#endif
-		}
-		else if (fabs(ray.z) > 0.0001f)
+	FOR_ELEMS(data, state->game.render_thread_datas, state->game.render_thread_count)
+	{
+		FOR_ELEMS(it, data->stage_counters)
 		{
-#if DEBUG_DISABLE_FLOOR_CEILING
-			*current_pixel = 0;
-#else
-			vf2      uv;
-			f32      distance;
-			vf3      normal;
-			Mipmap*  mipmap;
-			Material material;
+			*it = 0;
+		}
+	}
 
-			if (y < VIEW_RES.y / 2)
-			{
-				f32 zk   = -state->game.lucia_position.z / ray.z;
-				uv       = state->game.lucia_position.xy + zk * ray.xy;
-				distance = sqrtf(norm_sq(uv - state->game.lucia_position.xy) + square(state->game.lucia_position.z));
-				normal   = { 0.0f, 0.0f, 1.0f };
-				mipmap   = &state->game.mipmap.floor;
-				material = Material::floor;
+	u64 view_scope = profiler_begin("view");
 
-				f32 floor_dim = MAP_DIM * WALL_SPACING / roundf(MAP_DIM * WALL_SPACING / 4.0f);
-				uv.x = mod(uv.x / floor_dim + cosf(state->time / 5.0f) * state->game.interpolated_pills_effect_activations[2] * 8.0f / (distance + 4.0f), 1.0f);
-				uv.y = mod(uv.y / floor_dim + sinf(state->time / 5.0f) * state->game.interpolated_pills_effect_activations[3] * 8.0f / (distance + 4.0f), 1.0f);
-			}
-			else
-			{
-				f32 zk   = (state->game.percieved_wall_height - state->game.lucia_position.z) / ray.z;
-				uv       = state->game.lucia_position.xy + zk * ray.xy;
-				distance = sqrtf(norm_sq(uv - state->game.lucia_position.xy) + square(state->game.percieved_wall_height - state->game.lucia_position.z));
-				normal   = { 0.0f, 0.0f, -1.0f };
-				mipmap   = &state->game.mipmap.ceiling;
-				material = Material::ceiling;
+	// @NOTE@ The cast doesn't need the monster's light, so the main thread builds it while the other render threads start casting and then joins them.
+	release_render_threads(state, RenderPhase::cast);
 
-				f32 ceiling_dim = MAP_DIM * WALL_SPACING / roundf(MAP_DIM * WALL_SPACING / 4.0f) + state->game.interpolated_pills_effect_activations[3];
-				uv.x = mod(uv.x / ceiling_dim + cosf(state->time / 8.0f) * state->game.interpolated_pills_effect_activations[3] * 16.0f / (distance + 3.0f), 1.0f);
-				uv.y = mod(uv.y / ceiling_dim + sinf(state->time / 8.0f) * state->game.interpolated_pills_effect_activations[2] * 16.0f / (distance + 3.0f), 1.0f);
-			}
+	u64 monster_light_counter = SDL_GetPerformanceCounter();
+	if (state->game.monster_timeout == 0.0f)
+	{
+		compute_monster_light_depths(state);
+	}
+	monster_light_counter = SDL_GetPerformanceCounter() - monster_light_counter;
 
-#if DEBUG_DISABLE_SAMPLING
-			*current_pixel = pack_color(vx3(clamp(2.0f / (distance + 0.1f) + square(ray.z), 0.0f, 1.0f)));
-#else
-			vf3 floor_ceiling_color =
-				sample_at
-				(
-					mipmap,
-					(distance / 16.0f + mipmap->level_count * square(1.0f - fabsf(dot(ray, normal)))) * (1.0f - state->game.interpolated_eye_drops_activation),
-					uv
-				);
+	join_render_threads(state);
 
-			*current_pixel =
-				pack_color
-				(
-					shader
-					(
-						state,
-						floor_ceiling_color,
-						material,
-						state->game.monster_timeout == 0.0f && exists_clear_way(state, state->game.lucia_position.xy + ray.xy * distance * SHADER_INV_EPSILON, state->game.monster_position.xy),
-						ray,
-						normal,
-						distance
-					)
-				);
-#endif
-#endif
-		}
+	u64 sprites_counter = SDL_GetPerformanceCounter();
+	compute_render_sprites(state);
+	sprites_counter = SDL_GetPerformanceCounter() - sprites_counter;
 
-		NEXT_Y:;
-		current_pixel += 1;
-	}
-}
+	release_render_threads(state, RenderPhase::shade);
+	join_render_threads(state);
 
-internal void render_every_nth_vertical_scan_lines(u32* view_pixels, State* state, MemoryArena arena, i32 start_x, i32 delta_x)
-{
-	for (i32 x = start_x; x < VIEW_RES.x; x += delta_x)
+	profiler_end(view_scope);
+
+	FOR_ELEMS(it, state->game.render_stage_counters)
 	{
-		render_vertical_scan_line(view_pixels + x * VIEW_RES.y, state, arena, x);
+		*it = 0;
 	}
-}
-
-internal int render_thread_work(void* void_data)
-{
-	RenderThreadData* data = reinterpret_cast<RenderThreadData*>(void_data);
+	state->game.render_stage_counters[+RenderStage::raycast] = monster_light_counter;
+	state->game.render_stage_counters[+RenderStage::sprites] = sprites_counter;
 
-	while (true)
+	FOR_ELEMS(data, state->game.render_thread_datas, state->game.render_thread_count)
 	{
-		SDL_SemWait(data->state->game.render_thread_clock_in);
-
-		if (data->state->game.render_thread_fired)
-		{
-			return 0;
-		}
-		else
+		FOR_ELEMS(it, data->stage_counters)
 		{
-			render_every_nth_vertical_scan_lines(data->state->game.render_thread_view_pixels, data->state, data->arena, data->index, ARRAY_CAPACITY(data->state->game.render_thread_datas) + 1);
-			SDL_SemPost(data->state->game.render_thread_clock_out);
+			state->game.render_stage_counters[it_index] += *it;
 		}
 	}
 }
@@ -2128,11 +4365,61 @@ internal void generate_map(State* state)
 
 internal void init_game(State* state)
 {
-	state->game.render_thread_view_pixels = memory_arena_allocate<u32>(&state->context_arena, VIEW_RES.x * VIEW_RES.y);
+	PROFILER_scope("init_game");
+
+	state->game.render_thread_view_pixels = memory_arena_allocate<u32>(&state->context_arena, VIEW_ROW_PITCH * VIEW_RES.y);
 	state->game.percieved_wall_height     = WALL_HEIGHT;
 
 	generate_map(state);
 
+	{
+		vi2 queue[MAP_DIM * MAP_DIM];
+		i32 queue_start = 0;
+		i32 queue_end   = 0;
+
+		FOR_RANGE(y, MAP_DIM)
+		{
+			FOR_RANGE(x, MAP_DIM)
+			{
+				if (+state->game.wall_voxels[y][x])
+				{
+					state->game.wall_clearances[y][x] = 0;
+					queue[queue_end]                  = { x, y };
+					queue_end                        += 1;
+				}
+				else
+				{
+					state->game.wall_clearances[y][x] = 255;
+				}
+			}
+		}
+
+		while (queue_start < queue_end) // @NOTE@ Breadth-first from every wall at once over the eight neighbors, which is the Chebyshev distance.
+		{
+			vi2 cell      = queue[queue_start];
+			i32 clearance = state->game.wall_clearances[cell.y][cell.x] + 1;
+			queue_start += 1;
+
+			FOR_RANGE(dy, -1, 2)
+			{
+				FOR_RANGE(dx, -1, 2)
+				{
+					vi2 neighbor = { mod(cell.x + dx, MAP_DIM), mod(cell.y + dy, MAP_DIM) };
+					if (state->game.wall_clearances[neighbor.y][neighbor.x] == 255 && clearance < 255)
+					{
+						state->game.wall_clearances[neighbor.y][neighbor.x] = static_cast<u8>(clearance);
+						queue[queue_end]                                    = neighbor;
+						queue_end                                          += 1;
+					}
+				}
+			}
+		}
+	}
+
+	build_path_graph(state);
+	build_path_clusters(state);
+	state->game.lucia_flow_root = { -1, -1 };
+
 	{
 		memory_arena_checkpoint(&state->transient_arena);
 
@@ -2227,6 +4514,51 @@ internal void init_game(State* state)
 		}
 	}
 
+	FOR_RANGE(y, MAP_DIM)
+	{
+		FOR_RANGE(x, MAP_DIM)
+		{
+			FOR_ELEMS(it, WALL_VOXEL_DATA)
+			{
+				FOR_RANGE(side_index, 2)
+				{
+					WallSide        wall_side  = { { x, y }, it->voxel, side_index ? -it->normal : it->normal };
+					WallDecoration* decoration = &state->game.wall_side_decorations[y][x][it_index][side_index];
+
+					*decoration = WallDecoration::none;
+					if (equal_wall_sides(wall_side, state->game.door_wall_side))
+					{
+						*decoration = +(state->game.door_wall_side.voxel & (WallVoxel::back_slash | WallVoxel::forward_slash)) ? WallDecoration::diagonal_door : WallDecoration::door;
+					}
+					else if (equal_wall_sides(wall_side, state->game.circuit_breaker_wall_side))
+					{
+						*decoration = +(state->game.door_wall_side.voxel & (WallVoxel::back_slash | WallVoxel::forward_slash)) ? WallDecoration::diagonal_circuit_breaker : WallDecoration::circuit_breaker;
+					}
+					else if (rng(static_cast<i32>((x + y) * 317.14f + y * 17102.012f + 962.0f)) < 0.1f)
+					{
+						f32 direction =
+							dot
+							(
+								rotate90(wall_side.normal),
+								normalize(ray_to_closest(get_position_of_wall_side(wall_side, 0.0f), get_position_of_wall_side(state->game.door_wall_side, 0.0f)))
+							);
+
+						constexpr f32 THRESHOLD = 0.7f;
+
+						if (direction < -THRESHOLD)
+						{
+							*decoration = WallDecoration::left_arrow;
+						}
+						else if (direction > THRESHOLD)
+						{
+							*decoration = WallDecoration::right_arrow;
+						}
+					}
+				}
+			}
+		}
+	}
+
 	state->game.lucia_position.z          = LUCIA_HEIGHT;
 	state->game.lucia_fov                 = TAU / 3.0f;
 	state->game.lucia_stamina             = 1.0f;
@@ -2318,21 +4650,34 @@ internal void boot_up_state(SDL_Renderer* renderer, State* state)
 
 		case StateContext::game:
 		{
-			state->game.render_thread_fired       = false;
-			state->game.render_thread_clock_in    = SDL_CreateSemaphore(0);
-			state->game.render_thread_clock_out   = SDL_CreateSemaphore(0);
-			FOR_ELEMS(it, state->game.render_thread_datas)
+			state->game.render_thread_fired     = false;
+			state->game.render_thread_clock_out = SDL_CreateSemaphore(0);
+			state->game.render_thread_count     = clamp(SDL_GetCPUCount(), 1, min(RENDER_THREAD_CAPACITY, RENDER_CHUNK_COUNT));
+			#if DEBUG_DISABLE_AVX
+			state->game.render_simd_level       = SIMDLevel::sse2;
+			#else
+			state->game.render_simd_level       = SDL_HasAVX512F() ? SIMDLevel::avx512 : SDL_HasAVX2() ? SIMDLevel::avx2 : SIMDLevel::sse2;
+			#endif
+			FOR_ELEMS(it, state->game.render_thread_datas, state->game.render_thread_count)
 			{
-				it->index  = it_index;
-				it->thread = SDL_CreateThread(render_thread_work, "render_thread_work", it);
-				it->arena  = memory_arena_reserve(&state->context_arena, KIBIBYTES_OF(1));
-				it->state  = state;
+				it->index = it_index;
+				it->state = state;
+
+				if (it_index)
+				{
+					it->clock_in = SDL_CreateSemaphore(0);
+					it->thread   = SDL_CreateThread(render_thread_work, "render_thread_work", it);
+				}
 			}
 
 			state->game.image.door             = init_image(DATA_DIR "overlays/door.png");
 			state->game.image.circuit_breaker  = init_image(DATA_DIR "overlays/circuit_breaker.png");
 			state->game.image.wall_left_arrow  = init_image(DATA_DIR "overlays/streak_left_0.png");
 			state->game.image.wall_right_arrow = init_image(DATA_DIR "overlays/streak_right_0.png");
+			premultiply_image(&state->game.image.door);
+			premultiply_image(&state->game.image.circuit_breaker);
+			premultiply_image(&state->game.image.wall_left_arrow);
+			premultiply_image(&state->game.image.wall_right_arrow);
 
 			state->game.texture_sprite.hand                    = init_texture_sprite(renderer, DATA_DIR "hand.png");
 			state->game.texture_sprite.flashlight_on           = init_texture_sprite(renderer, DATA_DIR "items/flashlight_on.png");
@@ -2353,6 +4698,11 @@ internal void boot_up_state(SDL_Renderer* renderer, State* state)
 			state->game.mipmap.floor   = init_mipmap(DATA_DIR "room/floor.jpg", 4);
 			state->game.mipmap.ceiling = init_mipmap(DATA_DIR "room/ceiling.jpg", 4);
 
+			if (!renderer) // @NOTE@ Headless; only what the software renderer samples from is needed.
+			{
+				break;
+			}
+
 			state->game.texture.screen                          = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET   , SCREEN_RES.x, SCREEN_RES.y);
 			state->game.texture.view                            = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STREAMING, VIEW_RES.x  , VIEW_RES.y  );
 			state->game.texture.circuit_breaker_switches[false] = IMG_LoadTexture(renderer, DATA_DIR "hud/circuit_breaker_switch_off.png");
@@ -2455,16 +4805,14 @@ internal void boot_down_state(State* state)
 		case StateContext::game:
 		{
 			state->game.render_thread_fired = true;
-			FOR_RANGE(ARRAY_CAPACITY(state->game.render_thread_datas))
-			{
-				SDL_SemPost(state->game.render_thread_clock_in);
-			}
-			FOR_ELEMS(it, state->game.render_thread_datas)
+			FOR_RANGE(i, 1, state->game.render_thread_count)
 			{
-				SDL_WaitThread(it->thread, 0);
+				aliasing data = state->game.render_thread_datas[i];
+				SDL_SemPost(data.clock_in);
+				SDL_WaitThread(data.thread, 0);
+				SDL_DestroySemaphore(data.clock_in);
 			}
 
-			SDL_DestroySemaphore(state->game.render_thread_clock_in);
 			SDL_DestroySemaphore(state->game.render_thread_clock_out);
 
 			FOR_ELEMS(it, state->game.images          ) { deinit_image(it);           }
@@ -2488,6 +4836,8 @@ extern "C" PROTOTYPE_INITIALIZE(initialize)
 	ASSERT(sizeof(State) <= platform->memory_capacity);
 	State* state = reinterpret_cast<State*>(platform->memory);
 
+	profiler_register_thread("main");
+
 	*state = {};
 
 	#if DEBUG
@@ -2526,6 +4876,8 @@ extern "C" PROTOTYPE_BOOT_UP(boot_up)
 	ASSERT(sizeof(State) <= platform->memory_capacity);
 	State* state = reinterpret_cast<State*>(platform->memory);
 
+	profiler_register_thread("main"); // @NOTE@ A reloaded DLL starts with a fresh profiler.
+
 #if DEBUG_SHOWCASE_MAP
 	state->DEBUG_thread_terminate = false;
 	state->DEBUG_halted   = SDL_CreateSemaphore(0);
@@ -2572,6 +4924,8 @@ extern "C" PROTOTYPE_BOOT_DOWN(boot_down)
 
 extern "C" PROTOTYPE_UPDATE(update)
 {
+	PROFILER_scope("update");
+
 	State* state = reinterpret_cast<State*>(platform->memory);
 
 #if DEBUG_SHOWCASE_RENDER
@@ -2588,6 +4942,13 @@ extern "C" PROTOTYPE_UPDATE(update)
 	state->time                 += platform->seconds_per_update;
 	state->transient_arena.used  = 0;
 
+#if DEBUG
+	if (PRESSED(Input::n0))
+	{
+		profiler_export_chrome_trace(EXE_DIR "trace.json");
+	}
+#endif
+
 	if (HOLDING(Input::alt) && PRESSED(Input::enter))
 	{
 		if (platform->window_state == WindowState::windowed)
@@ -2643,7 +5004,7 @@ extern "C" PROTOTYPE_UPDATE(update)
 								{
 									case WindowType::room_protocol:
 									{
-										switch (+WindowButtonFamily::ROOM_PROTOCOL_START + +button_index)
+										switch (static_cast<WindowButtonFamily>(+WindowButtonFamily::ROOM_PROTOCOL_START + +button_index))
 										{
 											case WindowButtonFamily::room_protocol_lure:
 											{
@@ -2662,7 +5023,7 @@ extern "C" PROTOTYPE_UPDATE(update)
 
 									case WindowType::power:
 									{
-										switch (+WindowButtonFamily::POWER_START + +button_index)
+										switch (static_cast<WindowButtonFamily>(+WindowButtonFamily::POWER_START + +button_index))
 										{
 											case WindowButtonFamily::power_no:
 											{
@@ -4016,14 +6377,33 @@ extern "C" PROTOTYPE_UPDATE(update)
 						}
 					}
 
-					if (updated_monster_path_goal != state->game.monster_path_goal)
+					if (updated_monster_path_goal != state->game.monster_path_goal || !state->game.monster_path && state->game.monster_path_partial)
 					{
-						while (state->game.monster_path)
+						// @NOTE@ Lucia's cell is the goal when chasing, so the path is repaired along the flow field towards her instead of searched for again.
+						if (state->game.monster_chase_keytime || state->game.cowbell_keytime)
 						{
-							state->game.monster_path = deallocate_path_coordinates_node(state, state->game.monster_path);
+							set_lucia_flow_root(state, updated_monster_path_goal);
+							state->game.monster_path         = splice_lucia_flow_field(state, state->game.monster_path, get_closest_open_path_coordinates(state, state->game.monster_position.xy));
+							state->game.monster_path_partial = false;
+						}
+						else
+						{
+							while (state->game.monster_path)
+							{
+								state->game.monster_path = deallocate_path_coordinates_node(state, state->game.monster_path);
+							}
+
+							state->game.monster_path                  = path_find_hierarchical(state, get_closest_open_path_coordinates(state, state->game.monster_position.xy), updated_monster_path_goal);
+							state->game.monster_path_spliced_distance = INFINITY; // @NOTE@ The roaming path doesn't lead anywhere near Lucia, so it's not worth splicing once the chase starts.
+
+							PathCoordinatesNode* last_node = state->game.monster_path;
+							while (last_node && last_node->next_node)
+							{
+								last_node = last_node->next_node;
+							}
+							state->game.monster_path_partial = last_node && last_node->coordinates != updated_monster_path_goal;
 						}
 
-						state->game.monster_path      = path_find(state, get_closest_open_path_coordinates(state, state->game.monster_position.xy), updated_monster_path_goal);
 						state->game.monster_path_goal = updated_monster_path_goal;
 					}
 
@@ -4348,6 +6728,11 @@ extern "C" PROTOTYPE_UPDATE(update)
 			{
 				*it = dampen(*it, state->game.pills_effect_activations[it_index] * (sinf(state->time / 8.0f) + 1.0f) / 2.0f, 0.1f, platform->seconds_per_update);
 				state->game.pills_effect_activations[it_index] = max(state->game.pills_effect_activations[it_index] - platform->seconds_per_update / 60.0f, 0.0f);
+
+				if (state->game.pills_effect_activations[it_index] == 0.0f && *it < 0.0001f) // @NOTE@ The dampening stalls at a denormal instead of reaching zero, which the renderer's fast paths check for.
+				{
+					*it = 0.0f;
+				}
 			}
 
 			state->game.percieved_wall_height = dampen(state->game.percieved_wall_height, WALL_HEIGHT + state->game.interpolated_pills_effect_activations[1], 1.0f, platform->seconds_per_update);
@@ -4392,6 +6777,8 @@ extern "C" PROTOTYPE_UPDATE(update)
 
 extern "C" PROTOTYPE_RENDER(render)
 {
+	PROFILER_scope("render");
+
 	State* state = reinterpret_cast<State*>(platform->memory);
 
 #if DEBUG_SHOWCASE_RENDER
@@ -4685,130 +7072,18 @@ extern "C" PROTOTYPE_RENDER(render)
 			set_color(platform->renderer, vx3(0.0f));
 			SDL_RenderClear(platform->renderer);
 
-			DEBUG_PROFILER_create_group(RENDERING, VIEW, POST_PROCESSING);
-
-			DEBUG_PROFILER_start(RENDERING, VIEW);
-
-			FOR_RANGE(ARRAY_CAPACITY(state->game.render_thread_datas))
-			{
-				SDL_SemPost(state->game.render_thread_clock_in);
-			}
-
-			render_every_nth_vertical_scan_lines(state->game.render_thread_view_pixels, state, state->transient_arena, ARRAY_CAPACITY(state->game.render_thread_datas), ARRAY_CAPACITY(state->game.render_thread_datas) + 1);
-
-			FOR_RANGE(ARRAY_CAPACITY(state->game.render_thread_datas))
-			{
-				SDL_SemWait(state->game.render_thread_clock_out);
-			}
-
-			DEBUG_PROFILER_end(RENDERING, VIEW);
-
 			u32* view_texture_pixels;
 			i32  view_pitch_;
 			SDL_LockTexture(state->game.texture.view, 0, reinterpret_cast<void**>(&view_texture_pixels), &view_pitch_);
 
-			DEBUG_PROFILER_start(RENDERING, POST_PROCESSING);
-
-			__m128 m_blur =
-				state->game.interpolated_blur > 0.001f
-					? _mm_set_ps1(1.0f - expf(-platform->seconds_per_update / state->game.interpolated_blur))
-					: m_1;
-
-			__m128 m_max_x = _mm_set_ps1(static_cast<f32>(VIEW_RES.x));
-
-			__m128i mi_byte_mask                             = _mm_set_epi32(0xFF, 0xFF, 0xFF, 0xFF);
-			__m128  m_night_vision_goggles_activation        = _mm_set_ps1(state->game.night_vision_goggles_activation);
-			__m128  m_night_vision_goggles_scan_line_keytime = _mm_set_ps1(state->game.night_vision_goggles_scan_line_keytime);
-			__m128  m_night_vision_goggles_low_scan          = _mm_set_ps1(1.2f);
-			__m128  m_night_vision_goggles_r                 = _mm_set_ps1(0.0f);
-			__m128  m_night_vision_goggles_g                 = _mm_set_ps1(2.4f);
-			__m128  m_night_vision_goggles_b                 = _mm_set_ps1(0.0f);
-			__m128  m_flash                                  = _mm_set_ps1(1.0f + 128.0f * square(state->game.flash_stun_activation));
-
-			f32 interpolated_pill_dosage_total = 0.0f;
-			FOR_ELEMS(it, state->game.interpolated_pills_effect_activations)
-			{
-				interpolated_pill_dosage_total += *it;
-			}
-
-			__m128 m_high = _mm_add_ps(m_1, _mm_set_ps1(square(min(interpolated_pill_dosage_total, 0.15f))));
-
-			FOR_RANGE(y, VIEW_RES.y)
-			{
-				__m128 m_night_vision_goggles_scan_line = _mm_set_ps1(fabsf(0.5f - y % 3 / 3.0f));
-				__m128 m_x                              = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
-				__m128 m_blink                          = clamp(_mm_set_ps1(square(1.0f - state->game.lucia_blink_activation) - fabsf(1.0f - 2.0f * static_cast<f32>(y) / VIEW_RES.y) * state->game.lucia_blink_activation), m_0, m_1);
-				for (i32 x = 0; x < VIEW_RES.x; x += 4)
-				{
-					u32 old_view_colors[4];
-					u32 new_view_colors[4];
-					FOR_RANGE(xi, x, min(x + 4.0f, static_cast<f32>(VIEW_RES.x)))
-					{
-						old_view_colors[xi - x] = view_texture_pixels[y * VIEW_RES.x + xi];
-						new_view_colors[xi - x] = state->game.render_thread_view_pixels[xi * VIEW_RES.y + (VIEW_RES.y - 1 - y)];
-					}
-
-					__m128i mi_rgba = _mm_loadu_si128(reinterpret_cast<__m128i*>(old_view_colors));
-					__m128 m_old_r = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_epi32(_mm_bsrli_si128(mi_rgba, 3), mi_byte_mask)), m_255);
-					__m128 m_old_g = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_epi32(_mm_bsrli_si128(mi_rgba, 2), mi_byte_mask)), m_255);
-					__m128 m_old_b = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_epi32(_mm_bsrli_si128(mi_rgba, 1), mi_byte_mask)), m_255);
-
-					mi_rgba = _mm_loadu_si128(reinterpret_cast<__m128i*>(new_view_colors));
-					__m128 m_new_r = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_epi32(_mm_bsrli_si128(mi_rgba, 3), mi_byte_mask)), m_255);
-					__m128 m_new_g = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_epi32(_mm_bsrli_si128(mi_rgba, 2), mi_byte_mask)), m_255);
-					__m128 m_new_b = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_epi32(_mm_bsrli_si128(mi_rgba, 1), mi_byte_mask)), m_255);
-
-					#if DEBUG_DISABLE_POSTPROCESSOR
-					__m128 m_r = m_new_r;
-					__m128 m_g = m_new_g;
-					__m128 m_b = m_new_b;
-					#else
-					__m128 m_r = _mm_add_ps(_mm_mul_ps(m_old_r, _mm_sub_ps(m_1, m_blur)), _mm_mul_ps(m_new_r, m_blur));
-					__m128 m_g = _mm_add_ps(_mm_mul_ps(m_old_g, _mm_sub_ps(m_1, m_blur)), _mm_mul_ps(m_new_g, m_blur));
-					__m128 m_b = _mm_add_ps(_mm_mul_ps(m_old_b, _mm_sub_ps(m_1, m_blur)), _mm_mul_ps(m_new_b, m_blur));
-
-					__m128 m_night_vision_non_green_channel = _mm_sub_ps(m_1, m_night_vision_goggles_activation);
-					__m128 m_scan_line_delta                = _mm_mul_ps(_mm_sub_ps(_mm_div_ps(m_x, m_max_x), m_night_vision_goggles_scan_line_keytime), m_8);
-					m_scan_line_delta = _mm_min_ps(_mm_max_ps(_mm_mul_ps(m_scan_line_delta, m_scan_line_delta), m_0), m_1);
-
-					__m128 m_avg_rgb = _mm_div_ps(_mm_add_ps(_mm_add_ps(m_r, m_g), m_b), m_3);
-
-					__m128 m_t = _mm_add_ps(m_night_vision_goggles_low_scan, _mm_mul_ps(_mm_mul_ps(_mm_sub_ps(m_1, m_scan_line_delta), m_night_vision_goggles_scan_line), m_night_vision_goggles_activation));
-
-					m_r = _mm_mul_ps(lerp(m_r, _mm_mul_ps(m_avg_rgb, _mm_mul_ps(m_night_vision_goggles_r, m_t)), m_night_vision_goggles_activation), m_flash);
-					m_g = _mm_mul_ps(lerp(m_g, _mm_mul_ps(m_avg_rgb, _mm_mul_ps(m_night_vision_goggles_g, m_t)), m_night_vision_goggles_activation), m_flash);
-					m_b = _mm_mul_ps(lerp(m_b, _mm_mul_ps(m_avg_rgb, _mm_mul_ps(m_night_vision_goggles_b, m_t)), m_night_vision_goggles_activation), m_flash);
-
-					m_r = _mm_mul_ps(m_r, m_high);
-
-					m_r = _mm_mul_ps(clamp(m_r, m_0, m_1), m_blink);
-					m_g = _mm_mul_ps(clamp(m_g, m_0, m_1), m_blink);
-					m_b = _mm_mul_ps(clamp(m_b, m_0, m_1), m_blink);
-					#endif
-
-					mi_rgba =
-						_mm_or_epi32
-						(
-							_mm_or_epi32
-							(
-								_mm_bslli_si128(_mm_cvtps_epi32(_mm_mul_ps(m_r, m_255)), 3),
-								_mm_bslli_si128(_mm_cvtps_epi32(_mm_mul_ps(m_g, m_255)), 2)
-							),
-							_mm_bslli_si128(_mm_cvtps_epi32(_mm_mul_ps(m_b, m_255)), 1)
-						);
-
-					_mm_maskmoveu_si128(mi_rgba, _mm_castps_si128(_mm_cmplt_ps(m_x, m_max_x)), reinterpret_cast<char*>(view_texture_pixels + y * VIEW_RES.x + x));
-
-					m_x = _mm_add_ps(m_x, m_4);
-				}
-			}
-
-			DEBUG_PROFILER_end(RENDERING, POST_PROCESSING);
-
-			DEBUG_PROFILER_flush_group(RENDERING, 32, 1.0f / 60.0f);
+			render_view(state, platform->seconds_per_update, view_texture_pixels);
 
+			u64 upload_scope   = profiler_begin("upload");
+			u64 upload_counter = SDL_GetPerformanceCounter();
 			SDL_UnlockTexture(state->game.texture.view);
 			render_texture(platform->renderer, state->game.texture.view, { 0.0f, 0.0f }, { static_cast<f32>(VIEW_RES.x) / SCREEN_RES.x * DISPLAY_RES.x, static_cast<f32>(VIEW_RES.y) / SCREEN_RES.y * DISPLAY_RES.y });
+			state->game.render_stage_counters[+RenderStage::upload] = SDL_GetPerformanceCounter() - upload_counter;
+			profiler_end(upload_scope);
 
 			SDL_SetRenderTarget(platform->renderer, state->game.texture.screen);
 			set_color(platform->renderer, { 0.0f, 0.0f, 0.0f, 0.0f });
@@ -5156,3 +7431,37 @@ extern "C" PROTOTYPE_RENDER(render)
 
 	SDL_RenderPresent(platform->renderer);
 }
+
+extern "C" PROTOTYPE_RENDER_HEADLESS(render_headless)
+{
+	PROFILER_scope("render_headless");
+
+	State* state = reinterpret_cast<State*>(platform->memory);
+	ASSERT(state->context == StateContext::game);
+
+	state->transient_arena.used = 0;
+
+	render_view(state, platform->seconds_per_update, view_pixels);
+
+	if (display_pixels) // @NOTE@ Nearest-neighbor stretch of the view the same way `render` lays it out on the display; the HUD area is left black.
+	{
+		PROFILER_scope("upload");
+
+		u64 upload_counter = SDL_GetPerformanceCounter();
+
+		constexpr vi2 VIEW_DISPLAY_RES = { VIEW_RES.x * DISPLAY_RES.x / SCREEN_RES.x, VIEW_RES.y * DISPLAY_RES.y / SCREEN_RES.y };
+
+		FOR_RANGE(y, DISPLAY_RES.y)
+		{
+			FOR_RANGE(x, DISPLAY_RES.x)
+			{
+				display_pixels[y * DISPLAY_RES.x + x] =
+					x < VIEW_DISPLAY_RES.x && y < VIEW_DISPLAY_RES.y
+						? view_pixels[y * VIEW_RES.y / VIEW_DISPLAY_RES.y * VIEW_RES.x + x * VIEW_RES.x / VIEW_DISPLAY_RES.x]
+						: 0x000000FF;
+			}
+		}
+
+		state->game.render_stage_counters[+RenderStage::upload] = SDL_GetPerformanceCounter() - upload_counter;
+	}
+}
@@ -0,0 +1,266 @@
+// @NOTE@ Walks Lucia through a fixed map along a scripted path with the monster in view and reports how long each rendering stage took.
+// The seed, path, and frame count are fixed so numbers can be compared across commits and machines.
+// Usage : RoomBenchmark [frame_count] [seed] [frame_times.csv] [trace.json]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "Room.cpp"
+
+global constexpr i32 BENCHMARK_WARMUP_FRAMES  = 30;
+global constexpr f32 BENCHMARK_LUCIA_SPEED    = 3.0f;
+global constexpr i32 BENCHMARK_MONSTER_LEAD   = 4;
+global constexpr i32 BENCHMARK_HISTOGRAM_BINS = 16;
+
+enum_loose (BenchmarkTiming, u8)
+{
+	raycast,
+	sprites,
+	shading,
+	post_process,
+	upload,
+	frame,
+	CAPACITY
+};
+
+static_assert(+BenchmarkTiming::frame == +RenderStage::CAPACITY);
+
+global constexpr strlit BENCHMARK_TIMING_NAMES[+BenchmarkTiming::CAPACITY] =
+	{
+		"raycast",
+		"sprites",
+		"shading",
+		"post-process",
+		"upload",
+		"frame"
+	};
+
+struct BenchmarkPath
+{
+	vf2 waypoints[4096];
+	i32 waypoint_count;
+};
+
+// @NOTE@ Visits every item in the order they were spawned so that a mix of them passes through the view.
+internal void init_benchmark_path(BenchmarkPath* path, State* state)
+{
+	path->waypoint_count = 0;
+
+	vi2 start = get_closest_open_path_coordinates(state, state->game.lucia_position.xy);
+	FOR_ELEMS(it, state->game.item_buffer, state->game.item_count)
+	{
+		vi2 end = get_closest_open_path_coordinates(state, it->position.xy);
+		if (end == start)
+		{
+			continue;
+		}
+
+		state->transient_arena.used = 0;
+		PathCoordinatesNode* node = path_find(state, start, end);
+		while (node)
+		{
+			if (path->waypoint_count < ARRAY_CAPACITY(path->waypoints))
+			{
+				path->waypoints[path->waypoint_count] = path_coordinates_to_position(node->coordinates);
+				path->waypoint_count += 1;
+			}
+
+			node = deallocate_path_coordinates_node(state, node);
+		}
+
+		start = end;
+	}
+
+	ASSERT(path->waypoint_count > BENCHMARK_MONSTER_LEAD);
+}
+
+internal f64 get_percentile(f64* sorted_values, i32 count, f64 percentile)
+{
+	return sorted_values[clamp(static_cast<i32>(ceil(percentile * count)) - 1, 0, count - 1)];
+}
+
+int main(int argc, char** argv)
+{
+	i32    frame_count     = argc > 1 ? atoi(argv[1]) : 1200;
+	u32    seed            = argc > 2 ? static_cast<u32>(atoi(argv[2])) : 0;
+	strlit csv_file_path   = argc > 3 && argv[3][0] ? argv[3] : 0;
+	strlit trace_file_path = argc > 4 ? argv[4] : 0;
+
+	if (frame_count <= 0)
+	{
+		fprintf(stderr, "Frame count must be positive.\n");
+		return -1;
+	}
+
+	Platform platform = {};
+	platform.window_dimensions  = DISPLAY_RES;
+	platform.memory_capacity    = MEBIBYTES_OF(1);
+	platform.memory             = reinterpret_cast<byte*>(malloc(platform.memory_capacity));
+	platform.seconds_per_update = 1.0f / 60.0f;
+	DEFER { free(platform.memory); };
+
+	initialize(&platform);
+
+	State* state = reinterpret_cast<State*>(platform.memory);
+	state->seed    = seed;
+	state->context = StateContext::game;
+	boot_up_state(0, state);
+	init_game(state);
+	DEFER { boot_down_state(state); };
+
+	BenchmarkPath* path = reinterpret_cast<BenchmarkPath*>(malloc(sizeof(BenchmarkPath)));
+	DEFER { free(path); };
+	init_benchmark_path(path, state);
+
+	u32* view_pixels    = reinterpret_cast<u32*>(calloc(VIEW_RES.x    * VIEW_RES.y   , sizeof(u32)));
+	u32* display_pixels = reinterpret_cast<u32*>(calloc(DISPLAY_RES.x * DISPLAY_RES.y, sizeof(u32)));
+	f64* timings        = reinterpret_cast<f64*>(malloc(sizeof(f64) * +BenchmarkTiming::CAPACITY * frame_count)); // @NOTE@ Milliseconds; `timings[timing * frame_count + frame_index]`.
+	DEFER
+	{
+		free(view_pixels);
+		free(display_pixels);
+		free(timings);
+	};
+
+	f64 milliseconds_per_count = 1000.0 / SDL_GetPerformanceFrequency();
+	i32 waypoint_index         = 0;
+	state->game.lucia_position.xy = path->waypoints[0];
+
+	FOR_RANGE(frame_index, -BENCHMARK_WARMUP_FRAMES, frame_count)
+	{
+		if (update(&platform) == UpdateCode::terminate || state->context != StateContext::game)
+		{
+			fprintf(stderr, "Left the game context on frame %d.\n", frame_index);
+			return -1;
+		}
+
+		// @NOTE@ Overrides whatever `update` did to Lucia and the monster so every run renders the same frames.
+		{
+			vf2 ray = ray_to_closest(state->game.lucia_position.xy, path->waypoints[waypoint_index]);
+			if (norm(ray) < BENCHMARK_LUCIA_SPEED * platform.seconds_per_update)
+			{
+				waypoint_index = (waypoint_index + 1) % path->waypoint_count;
+			}
+			else
+			{
+				state->game.lucia_position.xy += normalize(ray) * BENCHMARK_LUCIA_SPEED * platform.seconds_per_update;
+				state->game.lucia_position.x   = mod(state->game.lucia_position.x, MAP_DIM * WALL_SPACING);
+				state->game.lucia_position.y   = mod(state->game.lucia_position.y, MAP_DIM * WALL_SPACING);
+				state->game.lucia_angle        = mod(atan2(ray) + 0.4f * sinf(state->time * 0.7f), TAU);
+			}
+
+			state->game.lucia_velocity = { 0.0f, 0.0f };
+			state->game.lucia_health   = 1.0f;
+
+			vf2 monster_position = path->waypoints[(waypoint_index + BENCHMARK_MONSTER_LEAD) % path->waypoint_count];
+			state->game.monster_timeout     = 0.0f;
+			state->game.monster_position.xy = monster_position;
+			state->game.monster_velocity    = { 0.0f, 0.0f };
+			state->game.monster_normal      = normalize(ray_to_closest(monster_position, state->game.lucia_position.xy));
+		}
+
+		u64 frame_counter = SDL_GetPerformanceCounter();
+		render_headless(&platform, view_pixels, display_pixels);
+		frame_counter = SDL_GetPerformanceCounter() - frame_counter;
+
+		if (frame_index >= 0)
+		{
+			FOR_ELEMS(it, state->game.render_stage_counters)
+			{
+				timings[it_index * frame_count + frame_index] = *it * milliseconds_per_count;
+			}
+
+			timings[+BenchmarkTiming::frame * frame_count + frame_index] = frame_counter * milliseconds_per_count;
+		}
+	}
+
+	if (trace_file_path && !profiler_export_chrome_trace(trace_file_path))
+	{
+		fprintf(stderr, "Failed to write '%s'.\n", trace_file_path);
+		return -1;
+	}
+
+	if (csv_file_path)
+	{
+		FILE* file = fopen(csv_file_path, "w");
+		if (!file)
+		{
+			fprintf(stderr, "Failed to open '%s'.\n", csv_file_path);
+			return -1;
+		}
+		DEFER { fclose(file); };
+
+		fprintf(file, "frame");
+		FOR_ELEMS(it, BENCHMARK_TIMING_NAMES)
+		{
+			fprintf(file, ",%s", *it);
+		}
+		fprintf(file, "\n");
+
+		FOR_RANGE(frame_index, frame_count)
+		{
+			fprintf(file, "%d", frame_index);
+			FOR_RANGE(timing_index, +BenchmarkTiming::CAPACITY)
+			{
+				fprintf(file, ",%.4f", timings[timing_index * frame_count + frame_index]);
+			}
+			fprintf(file, "\n");
+		}
+	}
+
+	printf("seed %u, %d frames after %d warm-up frames, %d waypoints, %d render threads\n", seed, frame_count, BENCHMARK_WARMUP_FRAMES, path->waypoint_count, state->game.render_thread_count);
+	printf("(raycast, sprites, shading, and post-process are summed across render threads; raycast also counts the main thread's monster light pass and sprites its sprite projection)\n\n");
+	printf("%-14s %10s %10s %10s %10s %10s\n", "stage (ms)", "min", "median", "p99", "max", "mean");
+
+	FOR_RANGE(timing_index, +BenchmarkTiming::CAPACITY)
+	{
+		f64* values = timings + timing_index * frame_count;
+		f64  total  = 0.0;
+		FOR_RANGE(i, frame_count)
+		{
+			total += values[i];
+		}
+
+		std::sort(values, values + frame_count);
+
+		printf
+		(
+			"%-14s %10.3f %10.3f %10.3f %10.3f %10.3f\n",
+			BENCHMARK_TIMING_NAMES[timing_index],
+			values[0],
+			get_percentile(values, frame_count, 0.50),
+			get_percentile(values, frame_count, 0.99),
+			values[frame_count - 1],
+			total / frame_count
+		);
+	}
+
+	{
+		f64* frame_times = timings + +BenchmarkTiming::frame * frame_count;
+		f64  bin_width   = (frame_times[frame_count - 1] - frame_times[0]) / BENCHMARK_HISTOGRAM_BINS;
+		i32  bins[BENCHMARK_HISTOGRAM_BINS] = {};
+
+		FOR_RANGE(i, frame_count)
+		{
+			bins[bin_width > 0.0 ? min(static_cast<i32>((frame_times[i] - frame_times[0]) / bin_width), BENCHMARK_HISTOGRAM_BINS - 1) : 0] += 1;
+		}
+
+		i32 most = 0;
+		FOR_ELEMS(it, bins)
+		{
+			most = max(most, *it);
+		}
+
+		printf("\nframe time histogram (ms)\n");
+		FOR_ELEMS(it, bins)
+		{
+			printf("%8.3f - %8.3f %6d ", frame_times[0] + bin_width * it_index, frame_times[0] + bin_width * (it_index + 1), *it);
+			FOR_RANGE(*it * 48 / most)
+			{
+				printf("#");
+			}
+			printf("\n");
+		}
+	}
+
+	return 0;
+}
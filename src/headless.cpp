@@ -0,0 +1,80 @@
+// @NOTE@ Runs the game without a window, renderer, or audio device and writes what the software renderer produced into PNGs.
+// Usage : RoomHeadless [frame_count] [seed] [view.png] [display.png]
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION true
+#include <stdio.h>
+#include <stdlib.h>
+#include <stb_image_write.h>
+#include "Room.cpp"
+
+internal bool32 write_png(strlit file_path, u32* pixels, vi2 dimensions)
+{
+	byte* rgb = reinterpret_cast<byte*>(malloc(static_cast<memsize>(dimensions.x * dimensions.y * 3)));
+	DEFER { free(rgb); };
+
+	FOR_RANGE(i, dimensions.x * dimensions.y) // @NOTE@ RGBA8888 has red in the most significant byte.
+	{
+		rgb[i * 3 + 0] = static_cast<byte>(pixels[i] >> 24);
+		rgb[i * 3 + 1] = static_cast<byte>(pixels[i] >> 16);
+		rgb[i * 3 + 2] = static_cast<byte>(pixels[i] >>  8);
+	}
+
+	return stbi_write_png(file_path, dimensions.x, dimensions.y, 3, rgb, dimensions.x * 3);
+}
+
+int main(int argc, char** argv)
+{
+	i32    frame_count       = argc > 1 ? atoi(argv[1]) : 60;
+	u32    seed              = argc > 2 ? static_cast<u32>(atoi(argv[2])) : 0;
+	strlit view_file_path    = argc > 3 ? argv[3] : "view.png";
+	strlit display_file_path = argc > 4 ? argv[4] : 0;
+
+	Platform platform = {};
+	platform.window_dimensions  = DISPLAY_RES;
+	platform.memory_capacity    = MEBIBYTES_OF(1);
+	platform.memory             = reinterpret_cast<byte*>(malloc(platform.memory_capacity));
+	platform.seconds_per_update = 1.0f / 60.0f;
+	DEFER { free(platform.memory); };
+
+	initialize(&platform);
+
+	State* state = reinterpret_cast<State*>(platform.memory);
+	state->seed    = seed;
+	state->context = StateContext::game;
+	boot_up_state(0, state);
+	init_game(state);
+	DEFER { boot_down_state(state); };
+
+	u32* view_pixels    = reinterpret_cast<u32*>(calloc(VIEW_RES.x * VIEW_RES.y, sizeof(u32)));
+	u32* display_pixels = display_file_path ? reinterpret_cast<u32*>(calloc(DISPLAY_RES.x * DISPLAY_RES.y, sizeof(u32))) : 0;
+	DEFER
+	{
+		free(view_pixels);
+		free(display_pixels);
+	};
+
+	FOR_RANGE(frame_index, frame_count)
+	{
+		if (update(&platform) == UpdateCode::terminate || state->context != StateContext::game)
+		{
+			fprintf(stderr, "Left the game context after %d frames.\n", frame_index);
+			break;
+		}
+
+		render_headless(&platform, view_pixels, display_pixels);
+	}
+
+	if (!write_png(view_file_path, view_pixels, VIEW_RES))
+	{
+		fprintf(stderr, "Failed to write '%s'.\n", view_file_path);
+		return -1;
+	}
+
+	if (display_pixels && !write_png(display_file_path, display_pixels, DISPLAY_RES))
+	{
+		fprintf(stderr, "Failed to write '%s'.\n", display_file_path);
+		return -1;
+	}
+
+	return 0;
+}
@@ -2,7 +2,7 @@
 #include <SDL.h>
 #include <SDL_ttf.h>
 #include <SDL_FontCache.h>
-#include <SDL_Mixer.h>
+#include <SDL_mixer.h>
 
 #include <SDL_image.h>
 
@@ -68,7 +68,7 @@ struct Platform
 	vi2           window_dimensions;
 	memsize       memory_capacity;
 	byte*         memory;
-	InputState    inputs[Input::CAPACITY];
+	InputState    inputs[+Input::CAPACITY];
 	vf2           cursor_delta;
 	vf2           cursor;
 	f32           scroll;
@@ -89,3 +89,6 @@ typedef PROTOTYPE_UPDATE(PrototypeUpdate);
 
 #define PROTOTYPE_RENDER(NAME) void NAME(Platform* platform)
 typedef PROTOTYPE_RENDER(PrototypeRender);
+
+#define PROTOTYPE_RENDER_HEADLESS(NAME) void NAME(Platform* platform, u32* view_pixels, u32* display_pixels)
+typedef PROTOTYPE_RENDER_HEADLESS(PrototypeRenderHeadless);
@@ -0,0 +1,140 @@
+// @NOTE@ Each thread records its scopes into its own ring buffer so recording never locks or contends; only the most recent `PROFILER_EVENT_CAPACITY` scopes per thread are kept.
+// `profiler_export_chrome_trace` writes the JSON that chrome://tracing and https://ui.perfetto.dev load.
+
+global constexpr i32 PROFILER_THREAD_CAPACITY = 32;
+global constexpr u64 PROFILER_EVENT_CAPACITY  = 8192;
+
+struct ProfilerEvent
+{
+	strlit name;
+	u64    begin_counter;
+	u64    end_counter;
+};
+
+struct ProfilerThread
+{
+	strlit        name;
+	u64           event_count;
+	ProfilerEvent events[PROFILER_EVENT_CAPACITY];
+};
+
+global struct
+{
+	SDL_atomic_t   thread_count;
+	ProfilerThread threads[PROFILER_THREAD_CAPACITY];
+} profiler;
+
+thread_local ProfilerThread* profiler_thread;
+thread_local bool32          profiler_thread_registered;
+
+#define PROFILER_scope(NAME)\
+	u64 MACRO_CONCAT_(PROFILER_SCOPE_, __LINE__) = profiler_begin(NAME);\
+	DEFER { profiler_end(MACRO_CONCAT_(PROFILER_SCOPE_, __LINE__)); }
+
+// @NOTE@ Registering again from the same thread only renames it.
+internal void profiler_register_thread(strlit name)
+{
+	if (!profiler_thread_registered)
+	{
+		profiler_thread_registered = true;
+
+		i32 index = SDL_AtomicAdd(&profiler.thread_count, 1);
+		if (index < PROFILER_THREAD_CAPACITY)
+		{
+			profiler_thread              = &profiler.threads[index];
+			profiler_thread->event_count = 0;
+		}
+	}
+
+	if (profiler_thread)
+	{
+		profiler_thread->name = name;
+	}
+}
+
+internal u64 profiler_begin(strlit name)
+{
+	if (!profiler_thread_registered)
+	{
+		profiler_register_thread("thread");
+	}
+
+	if (!profiler_thread)
+	{
+		return 0;
+	}
+
+	u64            index = profiler_thread->event_count;
+	ProfilerEvent* event = &profiler_thread->events[index % PROFILER_EVENT_CAPACITY];
+	event->name          = name;
+	event->end_counter   = 0;
+	event->begin_counter = SDL_GetPerformanceCounter();
+
+	profiler_thread->event_count += 1;
+
+	return index;
+}
+
+internal void profiler_end(u64 index)
+{
+	u64 counter = SDL_GetPerformanceCounter();
+
+	if (profiler_thread && profiler_thread->event_count - index <= PROFILER_EVENT_CAPACITY) // @NOTE@ The ring could've wrapped over the event if the scope was long.
+	{
+		profiler_thread->events[index % PROFILER_EVENT_CAPACITY].end_counter = counter;
+	}
+}
+
+// @NOTE@ Threads keep writing while this reads, so call this when the render threads are parked (e.g. between frames).
+internal bool32 profiler_export_chrome_trace(strlit file_path)
+{
+	FILE* file = fopen(file_path, "w");
+	if (!file)
+	{
+		return false;
+	}
+	DEFER { fclose(file); };
+
+	i32 thread_count = min(SDL_AtomicGet(&profiler.thread_count), PROFILER_THREAD_CAPACITY);
+
+	u64 origin_counter = UINT64_MAX;
+	FOR_ELEMS(thread, profiler.threads, thread_count)
+	{
+		for (u64 i = thread->event_count - min(thread->event_count, PROFILER_EVENT_CAPACITY); i < thread->event_count; i += 1)
+		{
+			origin_counter = min(origin_counter, thread->events[i % PROFILER_EVENT_CAPACITY].begin_counter);
+		}
+	}
+
+	f64 microseconds_per_count = 1000000.0 / SDL_GetPerformanceFrequency();
+
+	fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+	bool32 first = true;
+	FOR_ELEMS(thread, profiler.threads, thread_count)
+	{
+		fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", first ? "" : ",\n", thread_index, thread->name);
+		first = false;
+
+		for (u64 i = thread->event_count - min(thread->event_count, PROFILER_EVENT_CAPACITY); i < thread->event_count; i += 1)
+		{
+			ProfilerEvent* event = &thread->events[i % PROFILER_EVENT_CAPACITY];
+			if (event->end_counter)
+			{
+				fprintf
+				(
+					file,
+					",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+					event->name,
+					thread_index,
+					(event->begin_counter - origin_counter) * microseconds_per_count,
+					(event->end_counter - event->begin_counter) * microseconds_per_count
+				);
+			}
+		}
+	}
+
+	fprintf(file, "\n]}\n");
+
+	return true;
+}
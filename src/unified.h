@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <string.h>
 typedef uint8_t     byte;
 typedef uint64_t    memsize;
 typedef const char* strlit;
@@ -89,67 +90,10 @@ typedef double      f64;
 
 	#define DEBUG_once\
 	for (persist bool32 MACRO_CONCAT_(DEBUG_ONCE_, __LINE__) = true; MACRO_CONCAT_(DEBUG_ONCE_, __LINE__); MACRO_CONCAT_(DEBUG_ONCE_, __LINE__) = false)
-
-	#define DEBUG_PROFILER_create_group(GROUP_NAME, ...)\
-	enum struct GROUP_NAME : u8 { __VA_ARGS__, CAPACITY };\
-	constexpr strlit        MACRO_CONCAT_(GROUP_NAME, _STRS)[GROUP_NAME::CAPACITY] = { MACRO_STRINGIFY_ARGS_(__VA_ARGS__) };\
-	persist   LARGE_INTEGER MACRO_CONCAT_(GROUP_NAME, _LI_0)[GROUP_NAME::CAPACITY] = {};\
-	persist   LARGE_INTEGER MACRO_CONCAT_(GROUP_NAME, _LI_1)[GROUP_NAME::CAPACITY] = {};\
-	persist   u64           MACRO_CONCAT_(GROUP_NAME, _DATA)[GROUP_NAME::CAPACITY] = {}
-
-	#define DEBUG_PROFILER_flush_group(GROUP_NAME, COUNT, GOAL)\
-	do\
-	{\
-		if (persist u64 MACRO_CONCAT_(GROUP_NAME, _COUNTER) = 0; ++MACRO_CONCAT_(GROUP_NAME, _COUNTER) >= (COUNT))\
-		{\
-			MACRO_CONCAT_(GROUP_NAME, _COUNTER) = 0;\
-			u64           MACRO_CONCAT_(GROUP_NAME, _TOTAL) = 0;\
-			LARGE_INTEGER MACRO_CONCAT_(GROUP_NAME, _FREQUENCY);\
-			QueryPerformanceFrequency(&MACRO_CONCAT_(GROUP_NAME, _FREQUENCY));\
-			FOR_RANGE(MACRO_CONCAT_(GROUP_NAME, _INDEX), static_cast<u8>(GROUP_NAME::CAPACITY))\
-			{\
-				MACRO_CONCAT_(GROUP_NAME, _TOTAL) += MACRO_CONCAT_(GROUP_NAME, _DATA)[MACRO_CONCAT_(GROUP_NAME, _INDEX)];\
-			}\
-			DEBUG_printf\
-			(\
-				#GROUP_NAME " TOTAL\n\t(%fs) (%.2f%%) %llu\n",\
-				MACRO_CONCAT_(GROUP_NAME, _TOTAL) / static_cast<f64>((COUNT) * MACRO_CONCAT_(GROUP_NAME, _FREQUENCY).QuadPart),\
-				MACRO_CONCAT_(GROUP_NAME, _TOTAL) / static_cast<f64>((COUNT) * MACRO_CONCAT_(GROUP_NAME, _FREQUENCY).QuadPart) / (GOAL) * 100.0,\
-				MACRO_CONCAT_(GROUP_NAME, _TOTAL)\
-			);\
-			FOR_RANGE(MACRO_CONCAT_(GROUP_NAME, _INDEX), static_cast<u8>(GROUP_NAME::CAPACITY))\
-			{\
-				DEBUG_printf\
-				(\
-					"%s\n\t(%.3f) %llu\n",\
-					MACRO_CONCAT_(GROUP_NAME, _STRS)[MACRO_CONCAT_(GROUP_NAME, _INDEX)],\
-					MACRO_CONCAT_(GROUP_NAME, _DATA)[MACRO_CONCAT_(GROUP_NAME, _INDEX)] / static_cast<f64>(MACRO_CONCAT_(GROUP_NAME, _TOTAL)),\
-					MACRO_CONCAT_(GROUP_NAME, _DATA)[MACRO_CONCAT_(GROUP_NAME, _INDEX)]\
-				);\
-				MACRO_CONCAT_(GROUP_NAME, _DATA)[MACRO_CONCAT_(GROUP_NAME, _INDEX)] = 0;\
-			}\
-			DEBUG_printf("\n");\
-		}\
-	}\
-	while (false)
-
-	#define DEBUG_PROFILER_start(GROUP_NAME, SUBGROUP_NAME)\
-	do { QueryPerformanceCounter(&MACRO_CONCAT_(GROUP_NAME, _LI_0)[static_cast<u8>(GROUP_NAME::SUBGROUP_NAME)]); } while (false)
-
-	#define DEBUG_PROFILER_end(GROUP_NAME, SUBGROUP_NAME)\
-	do\
-	{\
-		QueryPerformanceCounter(&MACRO_CONCAT_(GROUP_NAME, _LI_1)[static_cast<u8>(GROUP_NAME::SUBGROUP_NAME)]);\
-		MACRO_CONCAT_(GROUP_NAME, _DATA)[static_cast<u8>(GROUP_NAME::SUBGROUP_NAME)] += MACRO_CONCAT_(GROUP_NAME, _LI_1)[static_cast<u8>(GROUP_NAME::SUBGROUP_NAME)].QuadPart - MACRO_CONCAT_(GROUP_NAME, _LI_0)[static_cast<u8>(GROUP_NAME::SUBGROUP_NAME)].QuadPart;\
-	} while (false)
 #else
 	#define ASSERT(EXPRESSION)
 	#define DEBUG_printf(FSTR, ...)
 	#define DEBUG_once                       if (true); else
-	#define DEBUG_PROFILER_create_group(...)
-	#define DEBUG_PROFILER_flush_group(...)
-	#define DEBUG_PROFILER_start(...)
-	#define DEBUG_PROFILER_end(...)
 #endif
 
 
@@ -250,6 +194,7 @@ internal MemoryArena memory_arena_reserve(MemoryArena* arena, memsize size)
 // Math.
 //
 
+#include <math.h>
 #include <algorithm>
 
 using std::clamp;
@@ -503,11 +448,6 @@ internal vf2 rotate(vf2 v, f32 angle)
 	return { v.x * p.x - v.y * p.y, v.x * p.y + v.y * p.x };
 }
 
-internal constexpr f32 dampen(f32 a, f32 b, f32 k, f32 dt) { return lerp(a, b, 1.0f - expf(-k * dt)); }
-internal constexpr vf2 dampen(vf2 a, vf2 b, f32 k, f32 dt) { return lerp(a, b, 1.0f - expf(-k * dt)); }
-internal constexpr vf3 dampen(vf3 a, vf3 b, f32 k, f32 dt) { return lerp(a, b, 1.0f - expf(-k * dt)); }
-internal constexpr vf4 dampen(vf4 a, vf4 b, f32 k, f32 dt) { return lerp(a, b, 1.0f - expf(-k * dt)); }
-
 internal constexpr f32 dot(vf2 u, vf2 v) { return u.x * v.x + u.y * v.y;                         }
 internal constexpr f32 dot(vf3 u, vf3 v) { return u.x * v.x + u.y * v.y + u.z * v.z;             }
 internal constexpr f32 dot(vf4 u, vf4 v) { return u.x * v.x + u.y * v.y + u.z * v.z + u.w * v.w; }
@@ -522,16 +462,29 @@ internal f32 norm(vf2 v) { return sqrtf(norm_sq(v)); }
 internal f32 norm(vf3 v) { return sqrtf(norm_sq(v)); }
 internal f32 norm(vf4 v) { return sqrtf(norm_sq(v)); }
 
-internal vf2 normalize(vf2 v) { return v / norm(v); }
-internal vf3 normalize(vf3 v) { return v / norm(v); }
-internal vf4 normalize(vf4 v) { return v / norm(v); }
-
 internal constexpr i32 mod(i32 x, i32 m) { return (x % m + m) % m; }
 internal           f32 mod(f32 x, f32 m) { f32 y = fmodf(x, m); return y < 0.0f ? y + m : y; }
 
 internal f32 atan2(vf2 v) { return atan2f(v.y, v.x); }
 
-#include <xmmintrin.h>
+#include <immintrin.h>
+
+// @NOTE@ MSVC lets AVX intrinsics appear anywhere; GCC and Clang need the functions using them to be compiled for the target.
+// Only call these functions after checking the CPU supports the instruction set.
+#if _MSC_VER
+	#define TARGET_AVX2
+	#define TARGET_AVX512
+#else
+	#define TARGET_AVX2   __attribute__((target("avx2")))
+	#define TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+// @NOTE@ For templates written once over the vector widths: they have no target of their own, so they have to be inlined into the targeted functions instantiating them.
+#if _MSC_VER
+	#define FORCE_INLINE __forceinline
+#else
+	#define FORCE_INLINE inline __attribute__((always_inline))
+#endif
 
 global const __m128 m_0   = _mm_set_ps1(0.0f);
 global const __m128 m_1   = _mm_set_ps1(1.0f);
@@ -546,3 +499,543 @@ internal __m128 square(__m128 x                    ) { return _mm_mul_ps(x, x);
 internal __m128 cube  (__m128 x                    ) { return _mm_mul_ps(_mm_mul_ps(x, x), x); }
 internal __m128 lerp  (__m128 a, __m128 b, __m128 t) { return _mm_add_ps(_mm_mul_ps(a, _mm_sub_ps(m_1, t)), _mm_mul_ps(b, t)); }
 internal __m128 clamp (__m128 x, __m128 a, __m128 b) { return _mm_min_ps(_mm_max_ps(x, a), b); }
+
+internal TARGET_AVX2 __m256 square(__m256 x                    ) { return _mm256_mul_ps(x, x); }
+internal TARGET_AVX2 __m256 lerp  (__m256 a, __m256 b, __m256 t) { return _mm256_add_ps(_mm256_mul_ps(a, _mm256_sub_ps(_mm256_set1_ps(1.0f), t)), _mm256_mul_ps(b, t)); }
+internal TARGET_AVX2 __m256 clamp (__m256 x, __m256 a, __m256 b) { return _mm256_min_ps(_mm256_max_ps(x, a), b); }
+
+internal TARGET_AVX512 __m512 square(__m512 x                    ) { return _mm512_mul_ps(x, x); }
+internal TARGET_AVX512 __m512 lerp  (__m512 a, __m512 b, __m512 t) { return _mm512_add_ps(_mm512_mul_ps(a, _mm512_sub_ps(_mm512_set1_ps(1.0f), t)), _mm512_mul_ps(b, t)); }
+internal TARGET_AVX512 __m512 clamp (__m512 x, __m512 a, __m512 b) { return _mm512_min_ps(_mm512_max_ps(x, a), b); }
+
+// @NOTE@ Approximations of libm for the render and update hot paths. `FAST_MATH` is the quality switch; when it's false every function here is the precise libm equivalent.
+// The error bounds are relative unless said otherwise and were measured against double precision over the stated domains.
+#ifndef FAST_MATH
+#define FAST_MATH true
+#endif
+
+// @NOTE@ `x` has to be finite and nonzero. One Newton step on `rcpps`, so within 2.5e-7.
+internal __m128 fast_rcp(__m128 x)
+{
+	#if FAST_MATH
+	__m128 m_y = _mm_rcp_ps(x);
+	return _mm_mul_ps(m_y, _mm_sub_ps(m_2, _mm_mul_ps(x, m_y)));
+	#else
+	return _mm_div_ps(m_1, x);
+	#endif
+}
+
+// @NOTE@ `x` has to be finite and positive. One Newton step on `rsqrtps`, so within 3.5e-7.
+internal __m128 fast_rsqrt(__m128 x)
+{
+	#if FAST_MATH
+	__m128 m_y = _mm_rsqrt_ps(x);
+	return _mm_mul_ps(_mm_mul_ps(_mm_set_ps1(0.5f), m_y), _mm_sub_ps(m_3, _mm_mul_ps(_mm_mul_ps(x, m_y), m_y)));
+	#else
+	return _mm_div_ps(m_1, _mm_sqrt_ps(x));
+	#endif
+}
+
+// @NOTE@ Within 1.5e-7 over [-87, 88]; `x` is clamped to that range.
+internal __m128 fast_exp(__m128 x)
+{
+	#if FAST_MATH
+	x = clamp(x, _mm_set_ps1(-87.0f), _mm_set_ps1(88.0f));
+
+	__m128i mi_n = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set_ps1(1.44269504f)));
+	__m128  m_n  = _mm_cvtepi32_ps(mi_n);
+	__m128  m_r  = _mm_sub_ps(_mm_sub_ps(x, _mm_mul_ps(m_n, _mm_set_ps1(0.693359375f))), _mm_mul_ps(m_n, _mm_set_ps1(-2.12194440e-4f))); // @NOTE@ Subtracts ln(2) in two parts so `m_r` stays exact.
+
+	__m128 m_p = _mm_set_ps1(1.9875691500e-4f);
+	m_p = _mm_add_ps(_mm_mul_ps(m_p, m_r), _mm_set_ps1(1.3981999507e-3f));
+	m_p = _mm_add_ps(_mm_mul_ps(m_p, m_r), _mm_set_ps1(8.3334519073e-3f));
+	m_p = _mm_add_ps(_mm_mul_ps(m_p, m_r), _mm_set_ps1(4.1665795894e-2f));
+	m_p = _mm_add_ps(_mm_mul_ps(m_p, m_r), _mm_set_ps1(1.6666665459e-1f));
+	m_p = _mm_add_ps(_mm_mul_ps(m_p, m_r), _mm_set_ps1(5.0000001201e-1f));
+	m_p = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m_p, square(m_r)), m_r), m_1);
+
+	return _mm_mul_ps(m_p, _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(mi_n, _mm_set1_epi32(127)), 23)));
+	#else
+	f32 xs[4];
+	_mm_storeu_ps(xs, x);
+	return _mm_set_ps(expf(xs[3]), expf(xs[2]), expf(xs[1]), expf(xs[0]));
+	#endif
+}
+
+// @NOTE@ Square-and-multiply, so within `n` times 6e-8.
+internal __m128 fast_pow(__m128 x, u32 n)
+{
+	#if FAST_MATH
+	__m128 m_y = m_1;
+	while (n)
+	{
+		if (n & 1)
+		{
+			m_y = _mm_mul_ps(m_y, x);
+		}
+		x   = square(x);
+		n >>= 1;
+	}
+	return m_y;
+	#else
+	f32 xs[4];
+	_mm_storeu_ps(xs, x);
+	f32 e = static_cast<f32>(n);
+	return _mm_set_ps(powf(xs[3], e), powf(xs[2], e), powf(xs[1], e), powf(xs[0], e));
+	#endif
+}
+
+// @NOTE@ Absolute error within 1.5e-7 over [-8192, 8192].
+internal void fast_sincos(__m128 x, __m128* sin, __m128* cos)
+{
+	#if FAST_MATH
+	__m128i mi_j = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set_ps1(4.0f / TAU)));
+	__m128  m_j  = _mm_cvtepi32_ps(mi_j);
+	__m128  m_r  = x; // @NOTE@ Subtracts multiples of TAU / 4 in three parts so `m_r` stays exact.
+	m_r = _mm_sub_ps(m_r, _mm_mul_ps(m_j, _mm_set_ps1(1.5703125f)));
+	m_r = _mm_sub_ps(m_r, _mm_mul_ps(m_j, _mm_set_ps1(4.837512969970703125e-4f)));
+	m_r = _mm_sub_ps(m_r, _mm_mul_ps(m_j, _mm_set_ps1(7.54978995489188216e-8f)));
+
+	__m128 m_r2 = square(m_r);
+	__m128 m_s  = _mm_add_ps(m_r, _mm_mul_ps(_mm_mul_ps(m_r, m_r2), _mm_add_ps(_mm_set_ps1(-1.6666654611e-1f), _mm_mul_ps(m_r2, _mm_add_ps(_mm_set_ps1(8.3321608736e-3f), _mm_mul_ps(m_r2, _mm_set_ps1(-1.9515295891e-4f)))))));
+	__m128 m_c  = _mm_add_ps(_mm_sub_ps(m_1, _mm_mul_ps(m_r2, _mm_set_ps1(0.5f))), _mm_mul_ps(square(m_r2), _mm_add_ps(_mm_set_ps1(4.166664568298827e-2f), _mm_mul_ps(m_r2, _mm_add_ps(_mm_set_ps1(-1.388731625493765e-3f), _mm_mul_ps(m_r2, _mm_set_ps1(2.443315711809948e-5f)))))));
+
+	__m128 m_swap     = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(mi_j, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+	__m128 m_sin_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(                mi_j                    , _mm_set1_epi32(2)), 30));
+	__m128 m_cos_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(mi_j, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+
+	*sin = _mm_xor_ps(_mm_or_ps(_mm_and_ps(m_swap, m_c), _mm_andnot_ps(m_swap, m_s)), m_sin_sign);
+	*cos = _mm_xor_ps(_mm_or_ps(_mm_and_ps(m_swap, m_s), _mm_andnot_ps(m_swap, m_c)), m_cos_sign);
+	#else
+	f32 xs[4];
+	_mm_storeu_ps(xs, x);
+	*sin = _mm_set_ps(sinf(xs[3]), sinf(xs[2]), sinf(xs[1]), sinf(xs[0]));
+	*cos = _mm_set_ps(cosf(xs[3]), cosf(xs[2]), cosf(xs[1]), cosf(xs[0]));
+	#endif
+}
+
+internal TARGET_AVX2 __m256 fast_rcp(__m256 x)
+{
+	#if FAST_MATH
+	__m256 m8_y = _mm256_rcp_ps(x);
+	return _mm256_mul_ps(m8_y, _mm256_sub_ps(_mm256_set1_ps(2.0f), _mm256_mul_ps(x, m8_y)));
+	#else
+	return _mm256_div_ps(_mm256_set1_ps(1.0f), x);
+	#endif
+}
+
+internal TARGET_AVX2 __m256 fast_rsqrt(__m256 x)
+{
+	#if FAST_MATH
+	__m256 m8_y = _mm256_rsqrt_ps(x);
+	return _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), m8_y), _mm256_sub_ps(_mm256_set1_ps(3.0f), _mm256_mul_ps(_mm256_mul_ps(x, m8_y), m8_y)));
+	#else
+	return _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(x));
+	#endif
+}
+
+internal TARGET_AVX2 __m256 fast_exp(__m256 x)
+{
+	#if FAST_MATH
+	x = clamp(x, _mm256_set1_ps(-87.0f), _mm256_set1_ps(88.0f));
+
+	__m256i mi8_n = _mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(1.44269504f)));
+	__m256  m8_n  = _mm256_cvtepi32_ps(mi8_n);
+	__m256  m8_r  = _mm256_sub_ps(_mm256_sub_ps(x, _mm256_mul_ps(m8_n, _mm256_set1_ps(0.693359375f))), _mm256_mul_ps(m8_n, _mm256_set1_ps(-2.12194440e-4f)));
+
+	__m256 m8_p = _mm256_set1_ps(1.9875691500e-4f);
+	m8_p = _mm256_add_ps(_mm256_mul_ps(m8_p, m8_r), _mm256_set1_ps(1.3981999507e-3f));
+	m8_p = _mm256_add_ps(_mm256_mul_ps(m8_p, m8_r), _mm256_set1_ps(8.3334519073e-3f));
+	m8_p = _mm256_add_ps(_mm256_mul_ps(m8_p, m8_r), _mm256_set1_ps(4.1665795894e-2f));
+	m8_p = _mm256_add_ps(_mm256_mul_ps(m8_p, m8_r), _mm256_set1_ps(1.6666665459e-1f));
+	m8_p = _mm256_add_ps(_mm256_mul_ps(m8_p, m8_r), _mm256_set1_ps(5.0000001201e-1f));
+	m8_p = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m8_p, square(m8_r)), m8_r), _mm256_set1_ps(1.0f));
+
+	return _mm256_mul_ps(m8_p, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(mi8_n, _mm256_set1_epi32(127)), 23)));
+	#else
+	f32 xs[8];
+	_mm256_storeu_ps(xs, x);
+	FOR_ELEMS(it, xs)
+	{
+		*it = expf(*it);
+	}
+	return _mm256_loadu_ps(xs);
+	#endif
+}
+
+internal TARGET_AVX2 __m256 fast_pow(__m256 x, u32 n)
+{
+	#if FAST_MATH
+	__m256 m8_y = _mm256_set1_ps(1.0f);
+	while (n)
+	{
+		if (n & 1)
+		{
+			m8_y = _mm256_mul_ps(m8_y, x);
+		}
+		x   = square(x);
+		n >>= 1;
+	}
+	return m8_y;
+	#else
+	f32 xs[8];
+	_mm256_storeu_ps(xs, x);
+	FOR_ELEMS(it, xs)
+	{
+		*it = powf(*it, static_cast<f32>(n));
+	}
+	return _mm256_loadu_ps(xs);
+	#endif
+}
+
+internal TARGET_AVX2 void fast_sincos(__m256 x, __m256* sin, __m256* cos)
+{
+	#if FAST_MATH
+	__m256i mi8_j = _mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(4.0f / TAU)));
+	__m256  m8_j  = _mm256_cvtepi32_ps(mi8_j);
+	__m256  m8_r  = x;
+	m8_r = _mm256_sub_ps(m8_r, _mm256_mul_ps(m8_j, _mm256_set1_ps(1.5703125f)));
+	m8_r = _mm256_sub_ps(m8_r, _mm256_mul_ps(m8_j, _mm256_set1_ps(4.837512969970703125e-4f)));
+	m8_r = _mm256_sub_ps(m8_r, _mm256_mul_ps(m8_j, _mm256_set1_ps(7.54978995489188216e-8f)));
+
+	__m256 m8_r2 = square(m8_r);
+	__m256 m8_s  = _mm256_add_ps(m8_r, _mm256_mul_ps(_mm256_mul_ps(m8_r, m8_r2), _mm256_add_ps(_mm256_set1_ps(-1.6666654611e-1f), _mm256_mul_ps(m8_r2, _mm256_add_ps(_mm256_set1_ps(8.3321608736e-3f), _mm256_mul_ps(m8_r2, _mm256_set1_ps(-1.9515295891e-4f)))))));
+	__m256 m8_c  = _mm256_add_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(m8_r2, _mm256_set1_ps(0.5f))), _mm256_mul_ps(square(m8_r2), _mm256_add_ps(_mm256_set1_ps(4.166664568298827e-2f), _mm256_mul_ps(m8_r2, _mm256_add_ps(_mm256_set1_ps(-1.388731625493765e-3f), _mm256_mul_ps(m8_r2, _mm256_set1_ps(2.443315711809948e-5f)))))));
+
+	__m256 m8_swap     = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(mi8_j, _mm256_set1_epi32(1)), _mm256_set1_epi32(1)));
+	__m256 m8_sin_sign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(                   mi8_j                       , _mm256_set1_epi32(2)), 30));
+	__m256 m8_cos_sign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(mi8_j, _mm256_set1_epi32(1)), _mm256_set1_epi32(2)), 30));
+
+	*sin = _mm256_xor_ps(_mm256_blendv_ps(m8_s, m8_c, m8_swap), m8_sin_sign);
+	*cos = _mm256_xor_ps(_mm256_blendv_ps(m8_c, m8_s, m8_swap), m8_cos_sign);
+	#else
+	f32 xs  [8];
+	f32 sins[8];
+	f32 coss[8];
+	_mm256_storeu_ps(xs, x);
+	FOR_ELEMS(it, xs)
+	{
+		sins[it_index] = sinf(*it);
+		coss[it_index] = cosf(*it);
+	}
+	*sin = _mm256_loadu_ps(sins);
+	*cos = _mm256_loadu_ps(coss);
+	#endif
+}
+
+internal f32 fast_rcp  (f32 x       ) { return _mm_cvtss_f32(fast_rcp  (_mm_set_ps1(x))   ); }
+internal f32 fast_rsqrt(f32 x       ) { return _mm_cvtss_f32(fast_rsqrt(_mm_set_ps1(x))   ); }
+internal f32 fast_exp  (f32 x       ) { return _mm_cvtss_f32(fast_exp  (_mm_set_ps1(x))   ); }
+
+internal f32 fast_pow(f32 x, u32 n)
+{
+	#if FAST_MATH
+	return _mm_cvtss_f32(fast_pow(_mm_set_ps1(x), n));
+	#else
+	return powf(x, static_cast<f32>(n));
+	#endif
+}
+
+internal vf2 fast_polar(f32 angle) // @NOTE@ Same as `polar` but through `fast_sincos`.
+{
+	__m128 m_sin;
+	__m128 m_cos;
+	fast_sincos(_mm_set_ps1(angle), &m_sin, &m_cos);
+	return { _mm_cvtss_f32(m_cos), _mm_cvtss_f32(m_sin) };
+}
+
+#if FAST_MATH
+internal vf2 normalize(vf2 v) { return v * fast_rsqrt(norm_sq(v)); }
+internal vf3 normalize(vf3 v) { return v * fast_rsqrt(norm_sq(v)); }
+internal vf4 normalize(vf4 v) { return v * fast_rsqrt(norm_sq(v)); }
+#else
+internal vf2 normalize(vf2 v) { return v / norm(v); }
+internal vf3 normalize(vf3 v) { return v / norm(v); }
+internal vf4 normalize(vf4 v) { return v / norm(v); }
+#endif
+
+internal f32 dampen(f32 a, f32 b, f32 k, f32 dt) { return lerp(a, b, 1.0f - fast_exp(-k * dt)); }
+internal vf2 dampen(vf2 a, vf2 b, f32 k, f32 dt) { return lerp(a, b, 1.0f - fast_exp(-k * dt)); }
+internal vf3 dampen(vf3 a, vf3 b, f32 k, f32 dt) { return lerp(a, b, 1.0f - fast_exp(-k * dt)); }
+internal vf4 dampen(vf4 a, vf4 b, f32 k, f32 dt) { return lerp(a, b, 1.0f - fast_exp(-k * dt)); }
+
+// @NOTE@ Structure-of-arrays counterparts of `f32`, `vf2`, and `vf3` that hold four (SSE), eight (AVX2), or sixteen (AVX-512) of them so data-parallel math can be written with the usual operators.
+// Comparisons return masks whose lanes are all ones or all zeros; use `select` to blend and `any`/`all`/`movemask` to branch on them.
+// The eight-wide types can only be used inside `TARGET_AVX2` functions and the sixteen-wide ones inside `TARGET_AVX512` functions, which only have arithmetic so far.
+struct f32x4    { __m128 m; };
+struct mask32x4 { __m128 m; };
+struct vf2x4    { f32x4 x; f32x4 y;          };
+struct vf3x4    { f32x4 x; f32x4 y; f32x4 z; };
+
+struct f32x8    { __m256 m; };
+struct mask32x8 { __m256 m; };
+struct vf2x8    { f32x8 x; f32x8 y;          };
+struct vf3x8    { f32x8 x; f32x8 y; f32x8 z; };
+
+struct f32x16   { __m512 m; };
+struct vf3x16   { f32x16 x; f32x16 y; f32x16 z; };
+
+internal f32x4    splat4(f32 a) { return { _mm_set_ps1(a) };                     }
+internal vf2x4    splat4(vf2 v) { return { splat4(v.x), splat4(v.y) };           }
+internal vf3x4    splat4(vf3 v) { return { splat4(v.x), splat4(v.y), splat4(v.z) }; }
+
+internal f32x4    operator- (f32x4    a            ) { return { _mm_sub_ps(m_0, a.m) };       }
+internal f32x4    operator+ (f32x4    a, f32x4    b) { return { _mm_add_ps(a.m, b.m) };       }
+internal f32x4    operator- (f32x4    a, f32x4    b) { return { _mm_sub_ps(a.m, b.m) };       }
+internal f32x4    operator* (f32x4    a, f32x4    b) { return { _mm_mul_ps(a.m, b.m) };       }
+internal f32x4    operator/ (f32x4    a, f32x4    b) { return { _mm_div_ps(a.m, b.m) };       }
+internal f32x4    operator+ (f32x4    a, f32      k) { return a + splat4(k);                  }
+internal f32x4    operator- (f32x4    a, f32      k) { return a - splat4(k);                  }
+internal f32x4    operator* (f32x4    a, f32      k) { return a * splat4(k);                  }
+internal f32x4    operator/ (f32x4    a, f32      k) { return a / splat4(k);                  }
+internal f32x4    operator+ (f32      k, f32x4    a) { return splat4(k) + a;                  }
+internal f32x4    operator- (f32      k, f32x4    a) { return splat4(k) - a;                  }
+internal f32x4    operator* (f32      k, f32x4    a) { return splat4(k) * a;                  }
+internal f32x4    operator/ (f32      k, f32x4    a) { return splat4(k) / a;                  }
+internal mask32x4 operator< (f32x4    a, f32x4    b) { return { _mm_cmplt_ps (a.m, b.m) };    }
+internal mask32x4 operator<=(f32x4    a, f32x4    b) { return { _mm_cmple_ps (a.m, b.m) };    }
+internal mask32x4 operator> (f32x4    a, f32x4    b) { return { _mm_cmpgt_ps (a.m, b.m) };    }
+internal mask32x4 operator>=(f32x4    a, f32x4    b) { return { _mm_cmpge_ps (a.m, b.m) };    }
+internal mask32x4 operator==(f32x4    a, f32x4    b) { return { _mm_cmpeq_ps (a.m, b.m) };    }
+internal mask32x4 operator!=(f32x4    a, f32x4    b) { return { _mm_cmpneq_ps(a.m, b.m) };    }
+internal mask32x4 operator& (mask32x4 a, mask32x4 b) { return { _mm_and_ps(a.m, b.m) };       }
+internal mask32x4 operator| (mask32x4 a, mask32x4 b) { return { _mm_or_ps (a.m, b.m) };       }
+internal mask32x4 operator^ (mask32x4 a, mask32x4 b) { return { _mm_xor_ps(a.m, b.m) };       }
+internal mask32x4 operator~ (mask32x4 a            ) { return { _mm_xor_ps(a.m, _mm_castsi128_ps(_mm_set1_epi32(-1))) }; }
+internal f32x4&   operator+=(f32x4&   a, f32x4    b) { return a = a + b; }
+internal f32x4&   operator-=(f32x4&   a, f32x4    b) { return a = a - b; }
+internal f32x4&   operator*=(f32x4&   a, f32x4    b) { return a = a * b; }
+internal f32x4&   operator/=(f32x4&   a, f32x4    b) { return a = a / b; }
+
+internal i32      movemask(mask32x4 a                    ) { return _mm_movemask_ps(a.m);                                                  }
+internal bool32   any     (mask32x4 a                    ) { return movemask(a) != 0;                                                      }
+internal bool32   all     (mask32x4 a                    ) { return movemask(a) == 0b1111;                                                 }
+internal f32x4    select  (mask32x4 c, f32x4 a, f32x4 b  ) { return { _mm_or_ps(_mm_and_ps(c.m, a.m), _mm_andnot_ps(c.m, b.m)) };          }
+internal vf2x4    select  (mask32x4 c, vf2x4 a, vf2x4 b  ) { return { select(c, a.x, b.x), select(c, a.y, b.y) };                          }
+internal vf3x4    select  (mask32x4 c, vf3x4 a, vf3x4 b  ) { return { select(c, a.x, b.x), select(c, a.y, b.y), select(c, a.z, b.z) };     }
+internal f32x4    square  (f32x4    x                    ) { return { square(x.m) };                                                       }
+internal f32x4    lerp    (f32x4    a, f32x4 b, f32x4 t  ) { return { lerp(a.m, b.m, t.m) };                                               }
+internal f32x4    clamp   (f32x4    x, f32x4 a, f32x4 b  ) { return { clamp(x.m, a.m, b.m) };                                              }
+internal f32x4    lerp    (f32x4    a, f32x4 b, f32   t  ) { return lerp(a, b, splat4(t));                                             }
+internal f32x4    clamp   (f32x4    x, f32   a, f32   b  ) { return clamp(x, splat4(a), splat4(b));                                    }
+internal f32x4    min     (f32x4    a, f32x4 b           ) { return { _mm_min_ps(a.m, b.m) };                                              }
+internal f32x4    max     (f32x4    a, f32x4 b           ) { return { _mm_max_ps(a.m, b.m) };                                              }
+internal f32x4    fabs    (f32x4    x                    ) { return { _mm_andnot_ps(_mm_set_ps1(-0.0f), x.m) };                            }
+internal f32x4    sqrt    (f32x4    x                    ) { return { _mm_sqrt_ps(x.m) };                                                  }
+internal f32x4    round   (f32x4    x                    ) { return { _mm_cvtepi32_ps(_mm_cvtps_epi32(x.m)) };                             } // @NOTE@ To the nearest even integer; `x` has to fit in an `i32`.
+internal f32x4    fast_rcp  (f32x4  x                    ) { return { fast_rcp  (x.m) };                                                   }
+internal f32x4    fast_rsqrt(f32x4  x                    ) { return { fast_rsqrt(x.m) };                                                   }
+
+internal vf2x4    operator- (vf2x4 v          ) { return { -v.x, -v.y             }; }
+internal vf3x4    operator- (vf3x4 v          ) { return { -v.x, -v.y, -v.z       }; }
+internal vf2x4    operator+ (vf2x4 u, vf2x4 v ) { return { u.x + v.x, u.y + v.y            }; }
+internal vf3x4    operator+ (vf3x4 u, vf3x4 v ) { return { u.x + v.x, u.y + v.y, u.z + v.z }; }
+internal vf2x4    operator- (vf2x4 u, vf2x4 v ) { return { u.x - v.x, u.y - v.y            }; }
+internal vf3x4    operator- (vf3x4 u, vf3x4 v ) { return { u.x - v.x, u.y - v.y, u.z - v.z }; }
+internal vf2x4    operator* (vf2x4 u, vf2x4 v ) { return { u.x * v.x, u.y * v.y            }; }
+internal vf3x4    operator* (vf3x4 u, vf3x4 v ) { return { u.x * v.x, u.y * v.y, u.z * v.z }; }
+internal vf2x4    operator* (vf2x4 v, f32x4 k ) { return { v.x * k, v.y * k          }; }
+internal vf3x4    operator* (vf3x4 v, f32x4 k ) { return { v.x * k, v.y * k, v.z * k }; }
+internal vf2x4    operator* (vf2x4 v, f32   k ) { return v * splat4(k); }
+internal vf3x4    operator* (vf3x4 v, f32   k ) { return v * splat4(k); }
+internal vf2x4    operator* (f32x4 k, vf2x4 v ) { return v * k; }
+internal vf3x4    operator* (f32x4 k, vf3x4 v ) { return v * k; }
+internal vf2x4    operator* (f32   k, vf2x4 v ) { return v * k; }
+internal vf3x4    operator* (f32   k, vf3x4 v ) { return v * k; }
+internal vf2x4    operator/ (vf2x4 v, f32x4 k ) { return { v.x / k, v.y / k          }; }
+internal vf3x4    operator/ (vf3x4 v, f32x4 k ) { return { v.x / k, v.y / k, v.z / k }; }
+internal vf2x4    operator/ (vf2x4 v, f32   k ) { return v / splat4(k); }
+internal vf3x4    operator/ (vf3x4 v, f32   k ) { return v / splat4(k); }
+internal vf2x4    operator+ (vf2x4 u, vf2   v ) { return u + splat4(v); }
+internal vf3x4    operator+ (vf3x4 u, vf3   v ) { return u + splat4(v); }
+internal vf2x4    operator- (vf2x4 u, vf2   v ) { return u - splat4(v); }
+internal vf3x4    operator- (vf3x4 u, vf3   v ) { return u - splat4(v); }
+internal vf2x4    operator- (vf2   u, vf2x4 v ) { return splat4(u) - v; }
+internal vf3x4    operator- (vf3   u, vf3x4 v ) { return splat4(u) - v; }
+internal vf2x4&   operator+=(vf2x4& u, vf2x4 v) { return u = u + v; }
+internal vf3x4&   operator+=(vf3x4& u, vf3x4 v) { return u = u + v; }
+internal vf2x4&   operator-=(vf2x4& u, vf2x4 v) { return u = u - v; }
+internal vf3x4&   operator-=(vf3x4& u, vf3x4 v) { return u = u - v; }
+internal vf2x4&   operator*=(vf2x4& v, f32x4 k) { return v = v * k; }
+internal vf3x4&   operator*=(vf3x4& v, f32x4 k) { return v = v * k; }
+
+internal f32x4    dot      (vf2x4 u, vf2x4 v         ) { return u.x * v.x + u.y * v.y;             }
+internal f32x4    dot      (vf3x4 u, vf3x4 v         ) { return u.x * v.x + u.y * v.y + u.z * v.z; }
+internal f32x4    norm_sq  (vf2x4 v                  ) { return dot(v, v);                         }
+internal f32x4    norm_sq  (vf3x4 v                  ) { return dot(v, v);                         }
+internal f32x4    norm     (vf2x4 v                  ) { return sqrt(norm_sq(v));                  }
+internal f32x4    norm     (vf3x4 v                  ) { return sqrt(norm_sq(v));                  }
+internal vf2x4    normalize(vf2x4 v                  ) { return v * fast_rsqrt(norm_sq(v));        }
+internal vf3x4    normalize(vf3x4 v                  ) { return v * fast_rsqrt(norm_sq(v));        }
+internal vf2x4    lerp     (vf2x4 a, vf2x4 b, f32x4 t) { return { lerp(a.x, b.x, t), lerp(a.y, b.y, t) };                    }
+internal vf3x4    lerp     (vf3x4 a, vf3x4 b, f32x4 t) { return { lerp(a.x, b.x, t), lerp(a.y, b.y, t), lerp(a.z, b.z, t) }; }
+internal vf2x4    rotate90 (vf2x4 v                  ) { return { -v.y, v.x };                     }
+
+internal vf2x4 load_vf2x4(vf2* vs) // @NOTE@ Gathers four consecutive `vf2` into lanes.
+{
+	__m128 m_01 = _mm_loadu_ps(&vs[0].x);
+	__m128 m_23 = _mm_loadu_ps(&vs[2].x);
+	return { { _mm_shuffle_ps(m_01, m_23, _MM_SHUFFLE(2, 0, 2, 0)) }, { _mm_shuffle_ps(m_01, m_23, _MM_SHUFFLE(3, 1, 3, 1)) } };
+}
+
+internal f32 get(f32x4 v, i32 lane)
+{
+	f32 xs[4];
+	_mm_storeu_ps(xs, v.m);
+	return xs[lane];
+}
+
+internal vf2 get(vf2x4 v, i32 lane)
+{
+	f32 xs[4];
+	f32 ys[4];
+	_mm_storeu_ps(xs, v.x.m);
+	_mm_storeu_ps(ys, v.y.m);
+	return { xs[lane], ys[lane] };
+}
+
+internal TARGET_AVX2 f32x8    splat8(f32 a) { return { _mm256_set1_ps(a) };                  }
+internal TARGET_AVX2 vf2x8    splat8(vf2 v) { return { splat8(v.x), splat8(v.y) };           }
+internal TARGET_AVX2 vf3x8    splat8(vf3 v) { return { splat8(v.x), splat8(v.y), splat8(v.z) }; }
+
+internal TARGET_AVX2 f32x8    operator- (f32x8    a            ) { return { _mm256_sub_ps(_mm256_setzero_ps(), a.m) }; }
+internal TARGET_AVX2 f32x8    operator+ (f32x8    a, f32x8    b) { return { _mm256_add_ps(a.m, b.m) };                  }
+internal TARGET_AVX2 f32x8    operator- (f32x8    a, f32x8    b) { return { _mm256_sub_ps(a.m, b.m) };                  }
+internal TARGET_AVX2 f32x8    operator* (f32x8    a, f32x8    b) { return { _mm256_mul_ps(a.m, b.m) };                  }
+internal TARGET_AVX2 f32x8    operator/ (f32x8    a, f32x8    b) { return { _mm256_div_ps(a.m, b.m) };                  }
+internal TARGET_AVX2 f32x8    operator+ (f32x8    a, f32      k) { return a + splat8(k);                                }
+internal TARGET_AVX2 f32x8    operator- (f32x8    a, f32      k) { return a - splat8(k);                                }
+internal TARGET_AVX2 f32x8    operator* (f32x8    a, f32      k) { return a * splat8(k);                                }
+internal TARGET_AVX2 f32x8    operator/ (f32x8    a, f32      k) { return a / splat8(k);                                }
+internal TARGET_AVX2 f32x8    operator+ (f32      k, f32x8    a) { return splat8(k) + a;                                }
+internal TARGET_AVX2 f32x8    operator- (f32      k, f32x8    a) { return splat8(k) - a;                                }
+internal TARGET_AVX2 f32x8    operator* (f32      k, f32x8    a) { return splat8(k) * a;                                }
+internal TARGET_AVX2 f32x8    operator/ (f32      k, f32x8    a) { return splat8(k) / a;                                }
+internal TARGET_AVX2 mask32x8 operator< (f32x8    a, f32x8    b) { return { _mm256_cmp_ps(a.m, b.m, _CMP_LT_OQ ) };     }
+internal TARGET_AVX2 mask32x8 operator<=(f32x8    a, f32x8    b) { return { _mm256_cmp_ps(a.m, b.m, _CMP_LE_OQ ) };     }
+internal TARGET_AVX2 mask32x8 operator> (f32x8    a, f32x8    b) { return { _mm256_cmp_ps(a.m, b.m, _CMP_GT_OQ ) };     }
+internal TARGET_AVX2 mask32x8 operator>=(f32x8    a, f32x8    b) { return { _mm256_cmp_ps(a.m, b.m, _CMP_GE_OQ ) };     }
+internal TARGET_AVX2 mask32x8 operator==(f32x8    a, f32x8    b) { return { _mm256_cmp_ps(a.m, b.m, _CMP_EQ_OQ ) };     }
+internal TARGET_AVX2 mask32x8 operator!=(f32x8    a, f32x8    b) { return { _mm256_cmp_ps(a.m, b.m, _CMP_NEQ_UQ) };     }
+internal TARGET_AVX2 mask32x8 operator& (mask32x8 a, mask32x8 b) { return { _mm256_and_ps(a.m, b.m) };                  }
+internal TARGET_AVX2 mask32x8 operator| (mask32x8 a, mask32x8 b) { return { _mm256_or_ps (a.m, b.m) };                  }
+internal TARGET_AVX2 mask32x8 operator^ (mask32x8 a, mask32x8 b) { return { _mm256_xor_ps(a.m, b.m) };                  }
+internal TARGET_AVX2 mask32x8 operator~ (mask32x8 a            ) { return { _mm256_xor_ps(a.m, _mm256_castsi256_ps(_mm256_set1_epi32(-1))) }; }
+internal TARGET_AVX2 f32x8&   operator+=(f32x8&   a, f32x8    b) { return a = a + b; }
+internal TARGET_AVX2 f32x8&   operator-=(f32x8&   a, f32x8    b) { return a = a - b; }
+internal TARGET_AVX2 f32x8&   operator*=(f32x8&   a, f32x8    b) { return a = a * b; }
+internal TARGET_AVX2 f32x8&   operator/=(f32x8&   a, f32x8    b) { return a = a / b; }
+
+internal TARGET_AVX2 i32      movemask(mask32x8 a                    ) { return _mm256_movemask_ps(a.m);                                         }
+internal TARGET_AVX2 bool32   any     (mask32x8 a                    ) { return movemask(a) != 0;                                                }
+internal TARGET_AVX2 bool32   all     (mask32x8 a                    ) { return movemask(a) == 0b11111111;                                       }
+internal TARGET_AVX2 f32x8    select  (mask32x8 c, f32x8 a, f32x8 b  ) { return { _mm256_blendv_ps(b.m, a.m, c.m) };                             }
+internal TARGET_AVX2 vf2x8    select  (mask32x8 c, vf2x8 a, vf2x8 b  ) { return { select(c, a.x, b.x), select(c, a.y, b.y) };                      }
+internal TARGET_AVX2 vf3x8    select  (mask32x8 c, vf3x8 a, vf3x8 b  ) { return { select(c, a.x, b.x), select(c, a.y, b.y), select(c, a.z, b.z) }; }
+internal TARGET_AVX2 f32x8    square  (f32x8    x                    ) { return { square(x.m) };                                                 }
+internal TARGET_AVX2 f32x8    lerp    (f32x8    a, f32x8 b, f32x8 t  ) { return { lerp(a.m, b.m, t.m) };                                         }
+internal TARGET_AVX2 f32x8    clamp   (f32x8    x, f32x8 a, f32x8 b  ) { return { clamp(x.m, a.m, b.m) };                                        }
+internal TARGET_AVX2 f32x8    lerp    (f32x8    a, f32x8 b, f32   t  ) { return lerp(a, b, splat8(t));                                       }
+internal TARGET_AVX2 f32x8    clamp   (f32x8    x, f32   a, f32   b  ) { return clamp(x, splat8(a), splat8(b));                              }
+internal TARGET_AVX2 f32x8    min     (f32x8    a, f32x8 b           ) { return { _mm256_min_ps(a.m, b.m) };                                     }
+internal TARGET_AVX2 f32x8    max     (f32x8    a, f32x8 b           ) { return { _mm256_max_ps(a.m, b.m) };                                     }
+internal TARGET_AVX2 f32x8    fabs    (f32x8    x                    ) { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x.m) };                }
+internal TARGET_AVX2 f32x8    sqrt    (f32x8    x                    ) { return { _mm256_sqrt_ps(x.m) };                                         }
+internal TARGET_AVX2 f32x8    round   (f32x8    x                    ) { return { _mm256_cvtepi32_ps(_mm256_cvtps_epi32(x.m)) };                 }
+internal TARGET_AVX2 f32x8    fast_rcp  (f32x8  x                    ) { return { fast_rcp  (x.m) };                                             }
+internal TARGET_AVX2 f32x8    fast_rsqrt(f32x8  x                    ) { return { fast_rsqrt(x.m) };                                             }
+
+internal TARGET_AVX2 vf2x8    operator- (vf2x8 v          ) { return { -v.x, -v.y             }; }
+internal TARGET_AVX2 vf3x8    operator- (vf3x8 v          ) { return { -v.x, -v.y, -v.z       }; }
+internal TARGET_AVX2 vf2x8    operator+ (vf2x8 u, vf2x8 v ) { return { u.x + v.x, u.y + v.y            }; }
+internal TARGET_AVX2 vf3x8    operator+ (vf3x8 u, vf3x8 v ) { return { u.x + v.x, u.y + v.y, u.z + v.z }; }
+internal TARGET_AVX2 vf2x8    operator- (vf2x8 u, vf2x8 v ) { return { u.x - v.x, u.y - v.y            }; }
+internal TARGET_AVX2 vf3x8    operator- (vf3x8 u, vf3x8 v ) { return { u.x - v.x, u.y - v.y, u.z - v.z }; }
+internal TARGET_AVX2 vf2x8    operator* (vf2x8 u, vf2x8 v ) { return { u.x * v.x, u.y * v.y            }; }
+internal TARGET_AVX2 vf3x8    operator* (vf3x8 u, vf3x8 v ) { return { u.x * v.x, u.y * v.y, u.z * v.z }; }
+internal TARGET_AVX2 vf2x8    operator* (vf2x8 v, f32x8 k ) { return { v.x * k, v.y * k          }; }
+internal TARGET_AVX2 vf3x8    operator* (vf3x8 v, f32x8 k ) { return { v.x * k, v.y * k, v.z * k }; }
+internal TARGET_AVX2 vf2x8    operator* (vf2x8 v, f32   k ) { return v * splat8(k); }
+internal TARGET_AVX2 vf3x8    operator* (vf3x8 v, f32   k ) { return v * splat8(k); }
+internal TARGET_AVX2 vf2x8    operator* (f32x8 k, vf2x8 v ) { return v * k; }
+internal TARGET_AVX2 vf3x8    operator* (f32x8 k, vf3x8 v ) { return v * k; }
+internal TARGET_AVX2 vf2x8    operator* (f32   k, vf2x8 v ) { return v * k; }
+internal TARGET_AVX2 vf3x8    operator* (f32   k, vf3x8 v ) { return v * k; }
+internal TARGET_AVX2 vf2x8    operator/ (vf2x8 v, f32x8 k ) { return { v.x / k, v.y / k          }; }
+internal TARGET_AVX2 vf3x8    operator/ (vf3x8 v, f32x8 k ) { return { v.x / k, v.y / k, v.z / k }; }
+internal TARGET_AVX2 vf2x8    operator/ (vf2x8 v, f32   k ) { return v / splat8(k); }
+internal TARGET_AVX2 vf3x8    operator/ (vf3x8 v, f32   k ) { return v / splat8(k); }
+internal TARGET_AVX2 vf2x8    operator+ (vf2x8 u, vf2   v ) { return u + splat8(v); }
+internal TARGET_AVX2 vf3x8    operator+ (vf3x8 u, vf3   v ) { return u + splat8(v); }
+internal TARGET_AVX2 vf2x8    operator- (vf2x8 u, vf2   v ) { return u - splat8(v); }
+internal TARGET_AVX2 vf3x8    operator- (vf3x8 u, vf3   v ) { return u - splat8(v); }
+internal TARGET_AVX2 vf2x8    operator- (vf2   u, vf2x8 v ) { return splat8(u) - v; }
+internal TARGET_AVX2 vf3x8    operator- (vf3   u, vf3x8 v ) { return splat8(u) - v; }
+internal TARGET_AVX2 vf2x8&   operator+=(vf2x8& u, vf2x8 v) { return u = u + v; }
+internal TARGET_AVX2 vf3x8&   operator+=(vf3x8& u, vf3x8 v) { return u = u + v; }
+internal TARGET_AVX2 vf2x8&   operator-=(vf2x8& u, vf2x8 v) { return u = u - v; }
+internal TARGET_AVX2 vf3x8&   operator-=(vf3x8& u, vf3x8 v) { return u = u - v; }
+internal TARGET_AVX2 vf2x8&   operator*=(vf2x8& v, f32x8 k) { return v = v * k; }
+internal TARGET_AVX2 vf3x8&   operator*=(vf3x8& v, f32x8 k) { return v = v * k; }
+
+internal TARGET_AVX2 f32x8    dot      (vf2x8 u, vf2x8 v         ) { return u.x * v.x + u.y * v.y;             }
+internal TARGET_AVX2 f32x8    dot      (vf3x8 u, vf3x8 v         ) { return u.x * v.x + u.y * v.y + u.z * v.z; }
+internal TARGET_AVX2 f32x8    norm_sq  (vf2x8 v                  ) { return dot(v, v);                         }
+internal TARGET_AVX2 f32x8    norm_sq  (vf3x8 v                  ) { return dot(v, v);                         }
+internal TARGET_AVX2 f32x8    norm     (vf2x8 v                  ) { return sqrt(norm_sq(v));                  }
+internal TARGET_AVX2 f32x8    norm     (vf3x8 v                  ) { return sqrt(norm_sq(v));                  }
+internal TARGET_AVX2 vf2x8    normalize(vf2x8 v                  ) { return v * fast_rsqrt(norm_sq(v));        }
+internal TARGET_AVX2 vf3x8    normalize(vf3x8 v                  ) { return v * fast_rsqrt(norm_sq(v));        }
+internal TARGET_AVX2 vf2x8    lerp     (vf2x8 a, vf2x8 b, f32x8 t) { return { lerp(a.x, b.x, t), lerp(a.y, b.y, t) };                    }
+internal TARGET_AVX2 vf3x8    lerp     (vf3x8 a, vf3x8 b, f32x8 t) { return { lerp(a.x, b.x, t), lerp(a.y, b.y, t), lerp(a.z, b.z, t) }; }
+internal TARGET_AVX2 vf2x8    rotate90 (vf2x8 v                  ) { return { -v.y, v.x };                     }
+
+internal TARGET_AVX2 vf2x8 load_vf2x8(vf2* vs) // @NOTE@ Gathers eight consecutive `vf2` into lanes.
+{
+	__m256 m8_0123 = _mm256_loadu_ps(&vs[0].x);
+	__m256 m8_4567 = _mm256_loadu_ps(&vs[4].x);
+	__m256 m8_xs   = _mm256_shuffle_ps(m8_0123, m8_4567, _MM_SHUFFLE(2, 0, 2, 0)); // @NOTE@ Lanes 0, 1, 4, 5, 2, 3, 6, 7.
+	__m256 m8_ys   = _mm256_shuffle_ps(m8_0123, m8_4567, _MM_SHUFFLE(3, 1, 3, 1));
+	return
+		{
+			{ _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(m8_xs), _MM_SHUFFLE(3, 1, 2, 0))) },
+			{ _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(m8_ys), _MM_SHUFFLE(3, 1, 2, 0))) }
+		};
+}
+
+internal TARGET_AVX2 vf2 get(vf2x8 v, i32 lane)
+{
+	f32 xs[8];
+	f32 ys[8];
+	_mm256_storeu_ps(xs, v.x.m);
+	_mm256_storeu_ps(ys, v.y.m);
+	return { xs[lane], ys[lane] };
+}
+
+internal TARGET_AVX512 f32x16   splat16(f32 a) { return { _mm512_set1_ps(a) }; }
+
+internal TARGET_AVX512 f32x16   operator- (f32x16   a            ) { return { _mm512_sub_ps(_mm512_setzero_ps(), a.m) }; }
+internal TARGET_AVX512 f32x16   operator+ (f32x16   a, f32x16   b) { return { _mm512_add_ps(a.m, b.m) };                  }
+internal TARGET_AVX512 f32x16   operator- (f32x16   a, f32x16   b) { return { _mm512_sub_ps(a.m, b.m) };                  }
+internal TARGET_AVX512 f32x16   operator* (f32x16   a, f32x16   b) { return { _mm512_mul_ps(a.m, b.m) };                  }
+internal TARGET_AVX512 f32x16   operator/ (f32x16   a, f32x16   b) { return { _mm512_div_ps(a.m, b.m) };                  }
+internal TARGET_AVX512 f32x16   operator+ (f32x16   a, f32      k) { return a + splat16(k);                               }
+internal TARGET_AVX512 f32x16   operator- (f32x16   a, f32      k) { return a - splat16(k);                               }
+internal TARGET_AVX512 f32x16   operator* (f32x16   a, f32      k) { return a * splat16(k);                               }
+internal TARGET_AVX512 f32x16   operator/ (f32x16   a, f32      k) { return a / splat16(k);                               }
+internal TARGET_AVX512 f32x16   operator+ (f32      k, f32x16   a) { return splat16(k) + a;                               }
+internal TARGET_AVX512 f32x16   operator- (f32      k, f32x16   a) { return splat16(k) - a;                               }
+internal TARGET_AVX512 f32x16   operator* (f32      k, f32x16   a) { return splat16(k) * a;                               }
+internal TARGET_AVX512 f32x16   operator/ (f32      k, f32x16   a) { return splat16(k) / a;                               }
+internal TARGET_AVX512 f32x16&  operator+=(f32x16&  a, f32x16   b) { return a = a + b; }
+internal TARGET_AVX512 f32x16&  operator-=(f32x16&  a, f32x16   b) { return a = a - b; }
+internal TARGET_AVX512 f32x16&  operator*=(f32x16&  a, f32x16   b) { return a = a * b; }
+internal TARGET_AVX512 f32x16&  operator/=(f32x16&  a, f32x16   b) { return a = a / b; }
+
+internal TARGET_AVX512 f32x16   square  (f32x16   x                    ) { return { square(x.m) };                                        }
+internal TARGET_AVX512 f32x16   lerp    (f32x16   a, f32x16 b, f32x16 t) { return { lerp(a.m, b.m, t.m) };                                }
+internal TARGET_AVX512 f32x16   lerp    (f32x16   a, f32x16 b, f32    t) { return lerp(a, b, splat16(t));                             }
+internal TARGET_AVX512 f32x16   clamp   (f32x16   x, f32x16 a, f32x16 b) { return { clamp(x.m, a.m, b.m) };                               }
+internal TARGET_AVX512 f32x16   clamp   (f32x16   x, f32    a, f32    b) { return clamp(x, splat16(a), splat16(b));                     }
+internal TARGET_AVX512 f32x16   min     (f32x16   a, f32x16 b          ) { return { _mm512_min_ps(a.m, b.m) };                            }
+internal TARGET_AVX512 f32x16   max     (f32x16   a, f32x16 b          ) { return { _mm512_max_ps(a.m, b.m) };                            }
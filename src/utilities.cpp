@@ -112,6 +112,17 @@ internal Image init_image(strlit file_path)
 	return image;
 }
 
+// @NOTE@ For images that are only ever composited through `blend_premultiplied`.
+internal void premultiply_image(Image* image)
+{
+	FOR_ELEMS(it, image->data, image->dim.x * image->dim.y)
+	{
+		it->r = static_cast<u8>((it->r * it->a + 127) / 255);
+		it->g = static_cast<u8>((it->g * it->a + 127) / 255);
+		it->b = static_cast<u8>((it->b * it->a + 127) / 255);
+	}
+}
+
 internal void deinit_image(Image* image)
 {
 	free(image->data);
@@ -122,8 +133,8 @@ internal TextureSprite init_texture_sprite(SDL_Renderer* renderer, strlit file_p
 	TextureSprite sprite;
 
 	sprite.image   = init_image(file_path);
-	sprite.texture = IMG_LoadTexture(renderer, file_path);
-	ASSERT(sprite.texture);
+	sprite.texture = renderer ? IMG_LoadTexture(renderer, file_path) : 0;
+	ASSERT(!renderer || sprite.texture);
 
 	return sprite;
 }
@@ -223,15 +234,45 @@ internal Image get_image_of_frame(AnimatedSprite* sprite)
 	return image;
 }
 
-internal vf4 sample_at(Image* image, vf2 uv)
+// @NOTE@ The texture samplers stay in `RGBA` so blending is done on bytes in 16-bit lanes; `rgba_to_color` widens to floats once the lighting needs them.
+internal RGBA sample_rgba_at(Image* image, vf2 uv)
 {
 	ASSERT(0.0f <= uv.x && uv.x <= 1.0f);
 	ASSERT(0.0f <= uv.y && uv.y <= 1.0f);
-	RGBA rgba = image->data[static_cast<i32>(uv.x * (image->dim.x - 1.0f)) * image->dim.y + static_cast<i32>((1.0f - uv.y) * (image->dim.y - 1.0f))];
-	return { rgba.r / 255.0f, rgba.g / 255.0f, rgba.b / 255.0f, rgba.a / 255.0f };
+	return image->data[static_cast<i32>(uv.x * (image->dim.x - 1.0f)) * image->dim.y + static_cast<i32>((1.0f - uv.y) * (image->dim.y - 1.0f))];
+}
+
+// @NOTE@ `t` is in 1/256ths. Red with blue and green with alpha are blended together as pairs of 16-bit lanes, which can't overflow since `255 * 256` fits.
+internal RGBA lerp(RGBA p, RGBA q, u32 t)
+{
+	ASSERT(t <= 256);
+	RGBA result;
+	result.rgba =
+		(((( p.rgba       & 0x00FF00FF) * (256 - t) + ( q.rgba       & 0x00FF00FF) * t) >> 8) & 0x00FF00FF) |
+		(((((p.rgba >> 8) & 0x00FF00FF) * (256 - t) + ((q.rgba >> 8) & 0x00FF00FF) * t)     ) & 0xFF00FF00);
+	return result;
 }
 
-internal vf3 sample_at(Mipmap* mipmap, f32 level, vf2 uv)
+// @NOTE@ `over` has to be premultiplied (see `premultiply_image`). `256 - a - a / 128` approximates `256 * (255 - a) / 255` and is exact at both ends.
+internal RGBA blend_premultiplied(RGBA under, RGBA over)
+{
+	u32  k = 256 - over.a - (over.a >> 7);
+	RGBA result;
+	result.rgba =
+		over.rgba +
+		(
+			(((( under.rgba       & 0x00FF00FF) * k) >> 8) & 0x00FF00FF) |
+			(((((under.rgba >> 8) & 0x00FF00FF) * k)     ) & 0xFF00FF00)
+		);
+	return result;
+}
+
+internal vf3 rgba_to_color(RGBA rgba)
+{
+	return vf3 { static_cast<f32>(rgba.r), static_cast<f32>(rgba.g), static_cast<f32>(rgba.b) } * (1.0f / 255.0f);
+}
+
+internal RGBA sample_rgba_at(Mipmap* mipmap, f32 level, vf2 uv)
 {
 #if DEBUG_DISABLE_MIPMAPPING
 	level = 0.0f;
@@ -259,14 +300,28 @@ internal vf3 sample_at(Mipmap* mipmap, f32 level, vf2 uv)
 				+ static_cast<i32>((1.0f - uv.y) * (mipmap->base_dim.y / (1 << (l + 1)) - 1.0f))
 			];
 
-		return vf3 { lerp(p.r, q.r, level - l), lerp(p.g, q.g, level - l), lerp(p.b, q.b, level - l) } / 255.0f; // @TODO@ Optimize this.
+		return lerp(p, q, static_cast<u32>((level - l) * 256.0f));
 	}
 	else
 	{
-		return vf3 { p.r / 255.0f, p.g / 255.0f, p.b / 255.0f };
+		return p;
 	}
 }
 
+// @NOTE@ The texels `sample_rgba_at` reads at a whole level for `u`, top-down, with `height` of them.
+internal RGBA* get_mipmap_column(Mipmap* mipmap, i32 level_index, f32 u, i32* height)
+{
+	ASSERT(IN_RANGE(level_index, 0, mipmap->level_count));
+	ASSERT(0.0f <= u && u <= 1.0f);
+
+	vi2 dim = mipmap->base_dim / (1 << level_index);
+	*height = dim.y;
+	return
+		mipmap->data
+			+ mipmap->base_dim.x * mipmap->base_dim.y * 4 / 3 - mipmap->base_dim.x * mipmap->base_dim.y * 4 / 3 / (1 << (level_index * 2))
+			+ static_cast<i32>(u * (dim.x - 1.0f)) * dim.y;
+}
+
 internal void age_animated_sprite(AnimatedSprite* sprite, f32 delta_time)
 {
 	sprite->age_keytime += delta_time * sprite->age_hertz;
@@ -294,6 +349,17 @@ internal bool32 ray_cast_line(f32* scalar, f32* portion, vf2 position, vf2 ray,
 	}
 }
 
+// @NOTE@ `ray_cast_line` on four rays from the same position at once; the lanes where it would've returned true are set in the mask.
+internal mask32x4 ray_cast_line(f32x4* scalar, f32x4* portion, vf2 position, vf2x4 ray, vf2 start, vf2 end)
+{
+	*scalar = ((start.x - end.x) * (start.y - position.y) - (start.y - end.y) * (start.x - position.x)) / ((start.x - end.x) * ray.y - (start.y - end.y) * ray.x);
+
+	f32x4 portion_c = start.x * ray.y - start.y * ray.x;
+	*portion = (portion_c + ray.x * position.y - ray.y * position.x) / (portion_c + ray.x * end.y - ray.y * end.x);
+
+	return ~(*scalar < splat4(0.0f));
+}
+
 enum struct Orientation : u8
 {
 	collinear,
@@ -675,7 +741,7 @@ internal void render_boxed_text(SDL_Renderer* renderer, FC_Font* font, vf2 coord
 template <typename... ARGUMENTS>
 internal void render_boxed_text(SDL_Renderer* renderer, FC_Font* font, vf2 coordinates, vf2 dimensions, FC_AlignEnum alignment, f32 scalar, vf3 color, strlit fstr, ARGUMENTS... arguments)
 {
-	render_boxed_text(renderer, font, coordinates, dimensions, alignment, scalar, vx4(color, 1.0f), fstr, arguments)
+	render_boxed_text(renderer, font, coordinates, dimensions, alignment, scalar, vxx(color, 1.0f), fstr, arguments...);
 }
 
 internal void render_line(SDL_Renderer* renderer, vf2 start, vf2 end)